@@ -15,8 +15,10 @@
  * - FIX: onended an ID gebunden (Race-Condition bei schnellem Umschalten)
  *
  * Protokoll:
- * - Empfängt: {"type": "stop"} und {"type": "play", "id": n}
+ * - Empfängt: {"type": "stop"} und {"type": "play", "id": n[, "pid": p]}
  * - Sendet:   {"type": "ended", "id": n}
+ * - Sendet:   {"type": "trace", "pid": p, "id": n, "play_ms": x}
+ *             (nur mit pid: Latenz-Messung, Empfang -> Wiedergabe)
  */
 
 // =============================================================================
@@ -286,7 +288,7 @@ function handleServerMessage(data) {
 
             case 'play':
                 if (typeof message.id === 'number') {
-                    handlePlay(message.id);
+                    handlePlay(message.id, message.pid);
                 } else {
                     log('Ungueltige play-Nachricht', 'warn');
                 }
@@ -338,7 +340,18 @@ function handleStop() {
     }
 }
 
-function handlePlay(id) {
+/**
+ * Meldet die Browser-Latenz (Empfang -> Wiedergabe) an den Server.
+ * Nur fuer Tastendruecke mit Korrelations-ID (Server: ESP32_LATENCY_TRACE).
+ */
+function reportTrace(pid, id, playMs) {
+    if (typeof pid !== 'number') {
+        return;
+    }
+    sendMessage({ type: 'trace', pid: pid, id: id, play_ms: Math.round(playMs * 10) / 10 });
+}
+
+function handlePlay(id, pid) {
     const startTime = performance.now();
     log(`PLAY: ${id}`);
 
@@ -394,8 +407,9 @@ function handlePlay(id) {
         cachedAudio.currentTime = 0;
         cachedAudio.play()
             .then(() => {
-                const latency = Math.round(performance.now() - startTime);
-                log(`Audio aus Cache gestartet: ${id3} (${latency}ms)`);
+                const elapsed = performance.now() - startTime;
+                log(`Audio aus Cache gestartet: ${id3} (${Math.round(elapsed)}ms)`);
+                reportTrace(pid, id, elapsed);
             })
             .catch((e) => log(`Audio-Fehler: ${e.message}`, 'error'));
     } else {
@@ -405,8 +419,9 @@ function handlePlay(id) {
 
         audio.play()
             .then(() => {
-                const latency = Math.round(performance.now() - startTime);
-                log(`Audio neu geladen: ${id3} (${latency}ms)`);
+                const elapsed = performance.now() - startTime;
+                log(`Audio neu geladen: ${id3} (${Math.round(elapsed)}ms)`);
+                reportTrace(pid, id, elapsed);
             })
             .catch((e) => log(`Audio-Fehler: ${e.message}`, 'error'));
     }
@@ -0,0 +1,363 @@
+/**
+ * @file main.cpp
+ * @brief Microbenchmark des IO-Hot-Paths (Logik ohne SPI)
+ *
+ * Misst pro Aufruf: Debouncer, VerticalDebouncer, Selection, BitSet-
+ * Vergleich/any(), Event- und Snapshot-Aufbau sowie die Logik eines ganzen
+ * IO-Zyklus (Schritte 2, 3, 5). Panelgroesse per Build-Option PANEL_SIZE.
+ *
+ * Zeitbasis:
+ * - ESP32-S3: CPU-Zyklenzaehler (CCOUNT), umgerechnet auf ns
+ * - Host (NATIVE_SIM): steady_clock
+ *
+ * Stabilitaet:
+ * - Feste Eingangsfolge (Taster mit Prellen, kein Zufall)
+ * - BENCH_REPS Wiederholungen, berichtet wird Median und Minimum
+ * - Ein Aufwaermdurchlauf wird verworfen
+ *
+ * Ausgabe (eine Zeile pro Messung, fuer tools/bench_compare.py):
+ *   BENCH <panel> <name> <median_ns> <min_ns> <allocs>
+ *
+ * Aufruf:
+ *   tools/bench.sh                      # Host, 10/100/255 Taster
+ *   pio run -e bench_esp32 -t upload -t monitor
+ */
+
+// =============================================================================
+// INCLUDES
+// =============================================================================
+
+#include "config.h"
+#include "types.h"
+#include <Arduino.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "logic/debounce.h"
+#include "logic/selection.h"
+#include "logic/vertical_debounce.h"
+
+#include <algorithm>
+#include <new>
+#include <stdarg.h>
+
+#if NATIVE_SIM
+#include <chrono>
+#endif
+
+// =============================================================================
+// KONSTANTEN
+// =============================================================================
+
+// Aufrufe pro Wiederholung (Host misst feiner, braucht mehr Aufrufe)
+constexpr uint32_t BENCH_ITERS = NATIVE_SIM ? 65536 : 4096;
+
+// Wiederholungen pro Messung (ungerade: Median ist ein Messwert)
+constexpr uint32_t BENCH_REPS = 15;
+
+// Laenge der Eingangsfolge (Zweierpotenz)
+constexpr uint32_t BENCH_FRAMES = 64;
+
+// =============================================================================
+// MODUL-LOKALE VARIABLEN
+// =============================================================================
+
+// Eingangsfolge: Rohwerte mit Prellen und entprellte Werte
+static btn_bits_t _raw_frames[BENCH_FRAMES];
+static btn_bits_t _deb_frames[BENCH_FRAMES];
+static btn_bits_t _idle;
+
+// Zustaende wie im IO-Task (statisch, kein Heap)
+static Debouncer _debouncer;
+static VerticalDebouncer _vertical;
+static Selection _selection;
+static log_channel_t _log;
+
+// Verhindert, dass der Compiler Ergebnisse wegoptimiert
+static volatile uint32_t _sink = 0;
+
+// Heap-Allokationen per operator new (Hot Path soll 0 haben)
+static volatile uint32_t _allocs = 0;
+
+// =============================================================================
+// HEAP-ZAEHLER
+// =============================================================================
+
+void *operator new(size_t size) {
+    _allocs = _allocs + 1;
+    void *p = malloc(size != 0 ? size : 1);
+    if (p == nullptr) {
+        abort();
+    }
+    return p;
+}
+
+void *operator new[](size_t size) { return operator new(size); }
+
+void operator delete(void *p) noexcept { free(p); }
+
+void operator delete[](void *p) noexcept { free(p); }
+
+void operator delete(void *p, size_t) noexcept { free(p); }
+
+void operator delete[](void *p, size_t) noexcept { free(p); }
+
+// =============================================================================
+// PRIVATE HILFSFUNKTIONEN
+// =============================================================================
+
+/**
+ * @brief Formatierte Ausgabe (Host: stdout, Target: USB-CDC)
+ */
+static void out(const char *fmt, ...) {
+    char line[128];
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(line, sizeof(line), fmt, args);
+    va_end(args);
+#if NATIVE_SIM
+    fputs(line, stdout);
+#else
+    Serial.print(line);
+#endif
+}
+
+/**
+ * @brief Zeitstempel in Ticks der jeweiligen Zeitbasis
+ */
+static inline uint32_t bench_ticks() {
+#if NATIVE_SIM
+    using namespace std::chrono;
+    return static_cast<uint32_t>(
+        duration_cast<nanoseconds>(steady_clock::now().time_since_epoch())
+            .count());
+#else
+    return ESP.getCycleCount();
+#endif
+}
+
+/**
+ * @brief Ticks -> Nanosekunden
+ */
+static inline double ticks_to_ns(uint32_t ticks) {
+#if NATIVE_SIM
+    return ticks;
+#else
+    return ticks * 1000.0 / ESP.getCpuFreqMHz();
+#endif
+}
+
+/**
+ * @brief Baut die Eingangsfolge: BENCH_FRAMES / 16 Druecke uebers Panel
+ *
+ * Pro Druck 16 Frames: 2 Prellen, 8 gedrueckt, 2 Prellen, 4 losgelassen.
+ * Entprellt: gedrueckt ab dem ersten stabilen Frame bis zum Loslassen.
+ */
+static void build_frames() {
+    _idle.fill(true);
+
+    for (uint32_t f = 0; f < BENCH_FRAMES; ++f) {
+        const uint32_t press = f / 16;
+        const uint32_t phase = f % 16;
+        const uint8_t id =
+            static_cast<uint8_t>(1 + (press * 37 + 5) % BTN_COUNT);
+
+        const bool bounce = (phase < 2) || (phase == 10 || phase == 11);
+        const bool raw_pressed = bounce ? (phase % 2 == 0) : (phase < 10);
+        const bool deb_pressed = (phase >= 2 && phase < 12);
+
+        _raw_frames[f] = _idle;
+        _deb_frames[f] = _idle;
+        activeLow_setPressed(_raw_frames[f], id, raw_pressed);
+        activeLow_setPressed(_deb_frames[f], id, deb_pressed);
+    }
+}
+
+/**
+ * @brief Misst body(i) fuer i = 0..BENCH_ITERS-1 und gibt eine Zeile aus
+ * @param name Messung (ohne Leerzeichen)
+ * @param body Callable mit Signatur uint32_t(uint32_t i), Ergebnis -> Sink
+ */
+template <typename F> static void run_bench(const char *name, F body) {
+    double ns_per_op[BENCH_REPS];
+    const uint32_t allocs_before = _allocs;
+
+    for (uint32_t rep = 0; rep <= BENCH_REPS; ++rep) {
+        uint32_t acc = 0;
+        const uint32_t t0 = bench_ticks();
+        for (uint32_t i = 0; i < BENCH_ITERS; ++i) {
+            acc += body(i);
+        }
+        const uint32_t t1 = bench_ticks();
+        _sink = _sink + acc;
+
+        if (rep > 0) { // Durchlauf 0 waermt Caches auf
+            ns_per_op[rep - 1] = ticks_to_ns(t1 - t0) / BENCH_ITERS;
+        }
+    }
+
+    std::sort(ns_per_op, ns_per_op + BENCH_REPS);
+    out("BENCH %u %-16s %9.1f %9.1f %u\n", (unsigned)BTN_COUNT, name,
+        ns_per_op[BENCH_REPS / 2], ns_per_op[0],
+        (unsigned)(_allocs - allocs_before));
+}
+
+/**
+ * @brief Alle Messungen fuer die aktuelle Panelgroesse
+ */
+static void run_all() {
+    build_frames();
+    out("# Panel %u Taster, %u Bytes, %u Woerter, %u x %u Aufrufe\n",
+        (unsigned)BTN_COUNT, (unsigned)BTN_BYTES, (unsigned)BTN_WORDS,
+        (unsigned)BENCH_REPS, (unsigned)BENCH_ITERS);
+    out("# BENCH <panel> <name> <median_ns> <min_ns> <allocs>\n");
+
+    btn_bits_t deb;
+    uint32_t now_ms = 0;
+
+    // Debouncer: Ruhezustand (haeufigster Fall) und Folge mit Prellen
+    _debouncer.init();
+    deb.fill(true);
+    run_bench("debounce_idle", [&](uint32_t) {
+        now_ms += IO_PERIOD_MS;
+        return _debouncer.update(now_ms, _idle, deb) ? 1u : 0u;
+    });
+    run_bench("debounce_bounce", [&](uint32_t i) {
+        now_ms += IO_PERIOD_MS;
+        return _debouncer.update(now_ms, _raw_frames[i % BENCH_FRAMES], deb)
+                   ? 1u
+                   : 0u;
+    });
+
+    // VerticalDebouncer: dieselben Eingaben
+    _vertical.init();
+    deb.fill(true);
+    run_bench("vertical_idle", [&](uint32_t) {
+        return _vertical.update(0, _idle, deb) ? 1u : 0u;
+    });
+    run_bench("vertical_bounce", [&](uint32_t i) {
+        return _vertical.update(0, _raw_frames[i % BENCH_FRAMES], deb) ? 1u
+                                                                       : 0u;
+    });
+
+    // Selection: entprellte Folge (Flanke alle 16 Frames)
+    _selection.init();
+    uint8_t active_id = 0;
+    run_bench("selection", [&](uint32_t i) {
+        return _selection.update(_deb_frames[i % BENCH_FRAMES], active_id)
+                   ? 1u
+                   : 0u;
+    });
+
+    // Vergleich raw != raw_prev und "irgendein Taster gedrueckt"
+    run_bench("bits_equal", [&](uint32_t i) {
+        return (_raw_frames[i % BENCH_FRAMES] ==
+                _raw_frames[(i + 1) % BENCH_FRAMES])
+                   ? 1u
+                   : 0u;
+    });
+    run_bench("any_pressed", [&](uint32_t i) {
+        return activeLow_any(_raw_frames[i % BENCH_FRAMES]) ? 1u : 0u;
+    });
+
+    // Events pro entprellter Flanke (wortweiser Diff) in den Ring
+    uint16_t seq = 0;
+    run_bench("event_build", [&](uint32_t i) {
+        const btn_bits_t &prev = _deb_frames[i % BENCH_FRAMES];
+        const btn_bits_t &cur = _deb_frames[(i + 1) % BENCH_FRAMES];
+        uint32_t n = 0;
+        btn_bits_t::diff(prev, cur).for_each_set([&](uint8_t id) {
+            io_event_t event;
+            event.us = i;
+            event.seq = seq++;
+            event.type = static_cast<uint8_t>(
+                activeLow_pressed(cur, id) ? IO_EVT_PRESS : IO_EVT_RELEASE);
+            event.id = id;
+            event.edge_us = i;
+            n += _log.events.push(event) ? 1u : 0u;
+        });
+        io_event_t drained;
+        while (_log.events.pop(drained)) {
+            n += drained.id;
+        }
+        return n;
+    });
+
+    // Voller Snapshot (Debug-Modus) inkl. Ring push/pop
+    led_bits_t leds;
+    run_bench("snapshot_build", [&](uint32_t i) {
+        log_event_t event = {};
+        event.ms = i;
+        event.raw = _raw_frames[i % BENCH_FRAMES];
+        event.deb = _deb_frames[i % BENCH_FRAMES];
+        event.led = leds;
+        event.active_id = active_id;
+        event.raw_changed = true;
+        _log.snapshots.push(event);
+        log_event_t drained;
+        return _log.snapshots.pop(drained) ? drained.ms : 0u;
+    });
+
+    // Logik eines IO-Zyklus: Vergleich, Entprellen, Auswahl, Events
+    _debouncer.init();
+    _selection.init();
+    deb.fill(true);
+    btn_bits_t deb_prev = deb;
+    active_id = 0;
+    run_bench("io_cycle_logic", [&](uint32_t i) {
+        const btn_bits_t &raw = _raw_frames[i % BENCH_FRAMES];
+        uint32_t n = (raw != _raw_frames[(i + BENCH_FRAMES - 1) % BENCH_FRAMES])
+                         ? 1u
+                         : 0u;
+        now_ms += IO_PERIOD_MS;
+        const bool deb_changed = _debouncer.update(now_ms, raw, deb);
+        const bool active_changed = _selection.update(deb, active_id);
+
+        if (deb_changed) {
+            btn_bits_t::diff(deb_prev, deb).for_each_set([&](uint8_t id) {
+                const io_event_type_e type = activeLow_pressed(deb, id)
+                                                 ? IO_EVT_PRESS
+                                                 : IO_EVT_RELEASE;
+                io_event_t event = {i, seq++, static_cast<uint8_t>(type), id,
+                                    i};
+                _log.events.push(event);
+            });
+            deb_prev = deb;
+        }
+        if (active_changed) {
+            io_event_t event = {i, seq++, IO_EVT_ACTIVE, active_id, i};
+            _log.events.push(event);
+        }
+        io_event_t drained;
+        while (_log.events.pop(drained)) {
+            n += drained.id;
+        }
+        return n;
+    });
+
+    out("# Ende Panel %u\n", (unsigned)BTN_COUNT);
+}
+
+// =============================================================================
+// ENTRY POINTS
+// =============================================================================
+
+#if NATIVE_SIM
+int main() {
+    run_all();
+    return 0;
+}
+#else
+void setup() {
+    // USB-CDC braucht Zeit zum Initialisieren
+    delay(1500);
+    Serial.begin(SERIAL_BAUD);
+    delay(500);
+
+    out("# ESP32-S3 %u MHz\n", (unsigned)ESP.getCpuFreqMHz());
+    run_all();
+}
+
+void loop() { vTaskDelay(portMAX_DELAY); }
+#endif
@@ -4,6 +4,7 @@
  *
  * Abstrahiert die Hardware-Eigenheiten von CD4021B (MSB-first) und
  * 74HC595 (LSB-first). ID 1-10 ist menschenfreundlich, intern 0-basiert.
+ * Die Zustaende selbst sind BitSets (bitset.h), die Reihenfolge steckt im Typ.
  */
 #ifndef BITOPS_H
 #define BITOPS_H
@@ -12,9 +13,28 @@
 // INCLUDES
 // =============================================================================
 
+#include "bitset.h"
 #include "config.h"
 #include <Arduino.h>
 
+// =============================================================================
+// TYPES
+// =============================================================================
+
+/**
+ * @brief Taster-Zustand in CD4021B-Reihenfolge (Active-Low, 1 = losgelassen)
+ */
+typedef BitSet<BTN_COUNT, BitOrder::MSB_FIRST> btn_bits_t;
+
+/**
+ * @brief LED-Zustand in 74HC595-Reihenfolge (1 = an)
+ */
+typedef BitSet<LED_COUNT, BitOrder::LSB_FIRST> led_bits_t;
+
+static_assert(btn_bits_t::BYTES == BTN_BYTES, "BTN_BYTES mismatch");
+static_assert(btn_bits_t::WORDS == BTN_WORDS, "BTN_WORDS mismatch");
+static_assert(led_bits_t::BYTES == LED_BYTES, "LED_BYTES mismatch");
+
 // =============================================================================
 // TASTER (CD4021B): MSB-first
 // =============================================================================
@@ -62,63 +82,54 @@ static inline uint8_t led_bit(uint8_t id) { return (id - 1) % 8; }
 
 /**
  * @brief Prueft ob Taster gedrueckt ist (Active-Low)
- * @param arr Taster-Array
+ * @param arr Taster-Zustand
  * @param id Taster-ID (1-basiert)
  * @return true wenn gedrueckt
  */
-static inline bool activeLow_pressed(const uint8_t *arr, uint8_t id) {
-    const uint8_t byte_idx = btn_byte(id);
-    const uint8_t bit_pos = btn_bit(id);
-    return !(arr[byte_idx] & (1u << bit_pos));
+static inline bool activeLow_pressed(const btn_bits_t &arr, uint8_t id) {
+    return !arr.test(id);
 }
 
 /**
  * @brief Setzt Taster-Zustand (Active-Low)
- * @param arr Taster-Array
+ * @param arr Taster-Zustand
  * @param id Taster-ID (1-basiert)
  * @param pressed true = gedrueckt
  */
-static inline void activeLow_setPressed(uint8_t *arr, uint8_t id,
+static inline void activeLow_setPressed(btn_bits_t &arr, uint8_t id,
                                         bool pressed) {
-    const uint8_t byte_idx = btn_byte(id);
-    const uint8_t bit_pos = btn_bit(id);
-    if (pressed) {
-        arr[byte_idx] &= ~(1u << bit_pos);
-    } else {
-        arr[byte_idx] |= (1u << bit_pos);
-    }
+    arr.set(id, !pressed);
 }
 
+/**
+ * @brief Prueft ob irgendein Taster gedrueckt ist (Active-Low)
+ * @param arr Taster-Zustand
+ * @return true wenn mindestens ein Taster gedrueckt
+ */
+static inline bool activeLow_any(const btn_bits_t &arr) { return !arr.all(); }
+
 // =============================================================================
 // LED HILFSFUNKTIONEN
 // =============================================================================
 
 /**
  * @brief Prueft ob LED eingeschaltet ist
- * @param arr LED-Array
+ * @param arr LED-Zustand
  * @param id LED-ID (1-basiert)
  * @return true wenn eingeschaltet
  */
-static inline bool led_on(const uint8_t *arr, uint8_t id) {
-    const uint8_t byte_idx = led_byte(id);
-    const uint8_t bit_pos = led_bit(id);
-    return (arr[byte_idx] >> bit_pos) & 1u;
+static inline bool led_on(const led_bits_t &arr, uint8_t id) {
+    return arr.test(id);
 }
 
 /**
  * @brief Setzt LED-Zustand
- * @param arr LED-Array
- * @param id LED-ID (1-basiert)
+ * @param arr LED-Zustand
+ * @param id LED-ID (1-basiert, ausserhalb 1..LED_COUNT ignoriert)
  * @param on true = einschalten
  */
-static inline void led_set(uint8_t *arr, uint8_t id, bool on) {
-    const uint8_t byte_idx = led_byte(id);
-    const uint8_t bit_pos = led_bit(id);
-    if (on) {
-        arr[byte_idx] |= (1u << bit_pos);
-    } else {
-        arr[byte_idx] &= ~(1u << bit_pos);
-    }
+static inline void led_set(led_bits_t &arr, uint8_t id, bool on) {
+    arr.set(id, on);
 }
 
 #endif // BITOPS_H
@@ -0,0 +1,307 @@
+/**
+ * @file bitset.h
+ * @brief Bit-Array fester Groesse mit Verdrahtungs-Reihenfolge als Typparameter
+ *
+ * Ersetzt rohe uint8_t-Arrays fuer Taster- und LED-Zustaende.
+ * Speicher sind 32-Bit-Woerter, die Byte-Sicht (data()) entspricht exakt
+ * dem SPI-Datenstrom der Schieberegister-Kette.
+ *
+ * Warum Woerter statt Bytes?
+ * - Vergleich, any(), count() etc. arbeiten auf 32 Bits pro Operation
+ * - Unbenutzte Bits sind per Invariante 0 (Masken zur Compile-Zeit)
+ * - ID -> Bit ist ein Shift und ein XOR (kein (id-1)/8 pro Byte)
+ *
+ * Speicherlayout (Little-Endian, ESP32-S3):
+ * Byte k der Kette liegt in Wort k/4, Bits 8*(k%4) bis 8*(k%4)+7.
+ * - MSB_FIRST (CD4021B): Index i -> Wort-Bit (i % 32) ^ 7
+ * - LSB_FIRST (74HC595): Index i -> Wort-Bit (i % 32)
+ */
+#ifndef BITSET_H
+#define BITSET_H
+
+// =============================================================================
+// INCLUDES
+// =============================================================================
+
+#include <stddef.h>
+#include <stdint.h>
+
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__,
+              "BitSet byte view requires little-endian words");
+
+// =============================================================================
+// TYPES
+// =============================================================================
+
+/**
+ * @brief Bit-Reihenfolge innerhalb eines Bytes der Kette
+ */
+enum class BitOrder : uint8_t {
+    MSB_FIRST, /**< Bit7 = erste ID (CD4021B: P1 zuerst) */
+    LSB_FIRST  /**< Bit0 = erste ID (74HC595: QA zuerst) */
+};
+
+// =============================================================================
+// CLASSES
+// =============================================================================
+
+/**
+ * @brief Bit-Array fuer N IDs (1-basiert) in Verdrahtungs-Reihenfolge
+ * @tparam N Anzahl Bits (Taster/LEDs)
+ * @tparam Order Bit-Reihenfolge der Hardware
+ */
+template <size_t N, BitOrder Order> class BitSet {
+public:
+    static constexpr size_t COUNT = N;               /**< Anzahl Bits */
+    static constexpr size_t BYTES = (N + 7) / 8;     /**< Bytes in der Kette */
+    static constexpr size_t WORDS = (N + 31) / 32;   /**< 32-Bit-Woerter */
+
+    static_assert(N > 0 && N <= 255, "BitSet supports 1..255 IDs");
+
+    /**
+     * @brief Konstruktor - alle Bits 0
+     */
+    constexpr BitSet() : _w{} {}
+
+    // -------------------------------------------------------------------------
+    // Compile-Zeit Masken
+    // -------------------------------------------------------------------------
+
+    /**
+     * @brief Maske der belegten Bits eines Worts
+     * @param w Wort-Index (0 bis WORDS-1)
+     * @return 1 = ID vorhanden, 0 = unbenutztes Tail-Bit
+     */
+    static constexpr uint32_t valid_mask(size_t w) {
+        return (N >= (w + 1) * 32) ? 0xFFFFFFFFu
+               : (N <= w * 32)     ? 0u
+                                   : byte_span_mask(N - (w * 32));
+    }
+
+    /**
+     * @brief Wort-Index fuer ID
+     * @param id ID (1-basiert)
+     */
+    static constexpr size_t word_of(uint8_t id) { return (id - 1u) / 32; }
+
+    /**
+     * @brief Bit-Maske fuer ID innerhalb ihres Worts
+     * @param id ID (1-basiert)
+     */
+    static constexpr uint32_t bit_of(uint8_t id) {
+        return 1u << word_pos((id - 1u) % 32);
+    }
+
+    // -------------------------------------------------------------------------
+    // Einzelbit-Zugriff
+    // -------------------------------------------------------------------------
+
+    /**
+     * @brief Liest Bit fuer ID
+     * @param id ID (1-basiert, 1..N)
+     * @return true wenn Bit gesetzt
+     */
+    constexpr bool test(uint8_t id) const {
+        return (_w[word_of(id)] & bit_of(id)) != 0;
+    }
+
+    /**
+     * @brief Setzt Bit fuer ID (ausserhalb 1..N wird ignoriert)
+     * @param id ID (1-basiert)
+     * @param value true = 1, false = 0
+     */
+    void set(uint8_t id, bool value) {
+        if (id < 1 || id > N) {
+            return;
+        }
+        if (value) {
+            _w[word_of(id)] |= bit_of(id);
+        } else {
+            _w[word_of(id)] &= ~bit_of(id);
+        }
+    }
+
+    // -------------------------------------------------------------------------
+    // Wortweise Operationen
+    // -------------------------------------------------------------------------
+
+    /**
+     * @brief Setzt alle belegten Bits auf value (Tail bleibt 0)
+     */
+    void fill(bool value) {
+        for (size_t w = 0; w < WORDS; ++w) {
+            _w[w] = value ? valid_mask(w) : 0u;
+        }
+    }
+
+    /**
+     * @brief Setzt unbenutzte Tail-Bits auf 0 (z.B. nach SPI-Read)
+     */
+    void mask_unused() {
+        if (N % 32 != 0) {
+            _w[WORDS - 1] &= valid_mask(WORDS - 1);
+        }
+    }
+
+    /**
+     * @brief Mindestens ein Bit gesetzt?
+     */
+    bool any() const {
+        uint32_t acc = 0;
+        for (size_t w = 0; w < WORDS; ++w) {
+            acc |= _w[w] & valid_mask(w);
+        }
+        return acc != 0;
+    }
+
+    /**
+     * @brief Alle belegten Bits gesetzt?
+     */
+    bool all() const {
+        uint32_t missing = 0;
+        for (size_t w = 0; w < WORDS; ++w) {
+            missing |= ~_w[w] & valid_mask(w);
+        }
+        return missing == 0;
+    }
+
+    /**
+     * @brief Anzahl gesetzter Bits (Popcount)
+     */
+    uint8_t count() const {
+        uint32_t n = 0;
+        for (size_t w = 0; w < WORDS; ++w) {
+            n += static_cast<uint32_t>(__builtin_popcount(_w[w] & valid_mask(w)));
+        }
+        return static_cast<uint8_t>(n);
+    }
+
+    /**
+     * @brief Bits, die sich zwischen a und b unterscheiden
+     */
+    static BitSet diff(const BitSet &a, const BitSet &b) {
+        BitSet r;
+        for (size_t w = 0; w < WORDS; ++w) {
+            r._w[w] = (a._w[w] ^ b._w[w]) & valid_mask(w);
+        }
+        return r;
+    }
+
+    /**
+     * @brief Ruft f(id) fuer jedes gesetzte Bit auf (aufsteigende ID)
+     * @param f Callable mit Signatur void(uint8_t id)
+     */
+    template <typename F> void for_each_set(F f) const {
+        for (size_t w = 0; w < WORDS; ++w) {
+            uint32_t x = _w[w] & valid_mask(w);
+            while (x != 0) {
+                const uint8_t pos = first_pos(x);
+                f(id_at(w, pos));
+                x &= ~(1u << pos);
+            }
+        }
+    }
+
+    /**
+     * @brief Hoechste ID unter den gesetzten Bits eines Worts
+     * @param w Wort-Index
+     * @param bits Bits im Layout dieses BitSets (!= 0)
+     * @return ID (1-basiert)
+     */
+    static uint8_t last_id_in_word(size_t w, uint32_t bits) {
+        return id_at(w, last_pos(bits));
+    }
+
+    /**
+     * @brief Liest Wort w (roh, inkl. Layout)
+     */
+    uint32_t word(size_t w) const { return _w[w]; }
+
+    /**
+     * @brief Schreibt Wort w (Tail-Bits werden maskiert)
+     */
+    void set_word(size_t w, uint32_t value) { _w[w] = value & valid_mask(w); }
+
+    // -------------------------------------------------------------------------
+    // Byte-Sicht (SPI-Datenstrom)
+    // -------------------------------------------------------------------------
+
+    /**
+     * @brief Bytes in Ketten-Reihenfolge [BYTES]
+     */
+    uint8_t *data() { return reinterpret_cast<uint8_t *>(_w); }
+
+    /**
+     * @brief Bytes in Ketten-Reihenfolge [BYTES] (nur lesend)
+     */
+    const uint8_t *data() const { return reinterpret_cast<const uint8_t *>(_w); }
+
+    bool operator==(const BitSet &o) const {
+        uint32_t acc = 0;
+        for (size_t w = 0; w < WORDS; ++w) {
+            acc |= _w[w] ^ o._w[w];
+        }
+        return acc == 0;
+    }
+
+    bool operator!=(const BitSet &o) const { return !(*this == o); }
+
+private:
+    /**
+     * @brief Index im Wort (0-31) -> Bit-Position im Wort
+     */
+    static constexpr uint8_t word_pos(uint32_t idx) {
+        return static_cast<uint8_t>((Order == BitOrder::MSB_FIRST) ? (idx ^ 7u)
+                                                                   : idx);
+    }
+
+    /**
+     * @brief Bit-Position im Wort -> ID (1-basiert)
+     */
+    static constexpr uint8_t id_at(size_t w, uint8_t pos) {
+        return static_cast<uint8_t>((w * 32) + word_pos(pos) + 1);
+    }
+
+    /**
+     * @brief Maske fuer die ersten n IDs eines Worts (0 < n < 32)
+     */
+    static constexpr uint32_t byte_span_mask(size_t n) {
+        return (Order == BitOrder::LSB_FIRST)
+                   ? ((1u << n) - 1u)
+                   // MSB-first: volle Bytes + obere (n % 8) Bits des Teilbytes
+                   : (((1u << ((n / 8) * 8)) - 1u) |
+                      ((n % 8 != 0)
+                           ? (((0xFFu << (8 - (n % 8))) & 0xFFu) << ((n / 8) * 8))
+                           : 0u));
+    }
+
+    /**
+     * @brief Position der kleinsten ID unter den gesetzten Bits
+     */
+    static uint8_t first_pos(uint32_t x) {
+        if (Order == BitOrder::LSB_FIRST) {
+            return static_cast<uint8_t>(__builtin_ctz(x));
+        }
+        // Niedrigstes belegtes Byte, darin das hoechste Bit
+        const uint8_t base = static_cast<uint8_t>(__builtin_ctz(x) & ~7);
+        const uint32_t byte = (x >> base) & 0xFFu;
+        return static_cast<uint8_t>(base + 31 - __builtin_clz(byte));
+    }
+
+    /**
+     * @brief Position der groessten ID unter den gesetzten Bits
+     */
+    static uint8_t last_pos(uint32_t x) {
+        if (Order == BitOrder::LSB_FIRST) {
+            return static_cast<uint8_t>(31 - __builtin_clz(x));
+        }
+        // Hoechstes belegtes Byte, darin das niedrigste Bit
+        const uint8_t base = static_cast<uint8_t>((31 - __builtin_clz(x)) & ~7);
+        const uint32_t byte = (x >> base) & 0xFFu;
+        return static_cast<uint8_t>(base + __builtin_ctz(byte));
+    }
+
+    uint32_t _w[WORDS]; /**< Bit-Speicher, unbenutzte Bits = 0 */
+};
+
+#endif // BITSET_H
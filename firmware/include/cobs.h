@@ -0,0 +1,109 @@
+/**
+ * @file cobs.h
+ * @brief COBS-Rahmung und CRC16 fuer das binaere Serial-Protokoll
+ *
+ * COBS (Consistent Overhead Byte Stuffing):
+ * - Kodierte Daten enthalten kein 0x00 → 0x00 trennt Frames eindeutig
+ * - Overhead: 1 Byte pro 254 Nutzbytes (bei kurzen Frames: genau 1 Byte)
+ * - Selbstsynchronisierend: nach Muell/Fragment beginnt der naechste
+ *   Frame sicher nach dem naechsten 0x00
+ *
+ * CRC16-CCITT (Poly 0x1021, Start 0xFFFF) erkennt verfaelschte Frames.
+ */
+#ifndef COBS_H
+#define COBS_H
+
+// =============================================================================
+// INCLUDES
+// =============================================================================
+
+#include <stddef.h>
+#include <stdint.h>
+
+// =============================================================================
+// INLINE FUNKTIONEN
+// =============================================================================
+
+/**
+ * @brief Maximale kodierte Laenge (ohne 0x00-Trenner)
+ * @param n Laenge der Rohdaten
+ */
+constexpr size_t cobs_max_encoded(size_t n) { return n + n / 254 + 1; }
+
+/**
+ * @brief Kodiert Rohdaten (ohne abschliessendes 0x00)
+ * @param in Rohdaten
+ * @param n Laenge der Rohdaten
+ * @param out Ziel (mind. cobs_max_encoded(n) Bytes)
+ * @return Kodierte Laenge
+ */
+static inline size_t cobs_encode(const uint8_t *in, size_t n, uint8_t *out) {
+    size_t code_pos = 0; // Position des aktuellen Code-Bytes
+    size_t o = 1;
+    uint8_t code = 1;
+
+    for (size_t i = 0; i < n; i++) {
+        if (in[i] == 0) {
+            out[code_pos] = code;
+            code_pos = o++;
+            code = 1;
+            continue;
+        }
+        out[o++] = in[i];
+        if (++code == 0xFF) {
+            out[code_pos] = code;
+            code_pos = o++;
+            code = 1;
+        }
+    }
+    out[code_pos] = code;
+    return o;
+}
+
+/**
+ * @brief Dekodiert einen Frame (ohne 0x00-Trenner)
+ * @param in Kodierte Daten
+ * @param n Kodierte Laenge
+ * @param out Ziel (mind. n Bytes)
+ * @return Laenge der Rohdaten, 0 bei ungueltiger Kodierung
+ */
+static inline size_t cobs_decode(const uint8_t *in, size_t n, uint8_t *out) {
+    size_t i = 0;
+    size_t o = 0;
+
+    while (i < n) {
+        const uint8_t code = in[i++];
+        if (code == 0 || i + code - 1 > n) {
+            return 0; // 0x00 im Frame oder Block laenger als Frame
+        }
+        for (uint8_t k = 1; k < code; k++) {
+            out[o++] = in[i++];
+        }
+        // Implizite Null zwischen Bloecken (nicht nach dem letzten, nicht
+        // nach vollem 254er-Block)
+        if (code != 0xFF && i < n) {
+            out[o++] = 0;
+        }
+    }
+    return o;
+}
+
+/**
+ * @brief CRC16-CCITT (Poly 0x1021, Start 0xFFFF, ohne Tabelle)
+ * @param data Daten
+ * @param n Laenge
+ * @return CRC
+ */
+static inline uint16_t crc16_ccitt(const uint8_t *data, size_t n) {
+    uint16_t crc = 0xFFFF;
+    for (size_t i = 0; i < n; i++) {
+        crc ^= (uint16_t)data[i] << 8;
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021)
+                                 : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+#endif // COBS_H
@@ -21,13 +21,22 @@
 // -----------------------------------------------------------------------------
 // Anzahl der Ein-/Ausgänge
 // -----------------------------------------------------------------------------
-constexpr uint8_t BTN_COUNT = 10;
-constexpr uint8_t LED_COUNT = 10;
+// PANEL_SIZE: Build-Option für Skalierungstests (z.B. -DPANEL_SIZE=100)
+// IDs sind uint8_t (0 = keine), daher höchstens 255 Taster/LEDs.
+#ifndef PANEL_SIZE
+#define PANEL_SIZE 10
+#endif
+
+constexpr uint8_t BTN_COUNT = PANEL_SIZE;
+constexpr uint8_t LED_COUNT = PANEL_SIZE;
 
 // Bytes für Bit-Arrays (aufrunden: 10 Bits → 2 Bytes)
 constexpr size_t BTN_BYTES = (BTN_COUNT + 7) / 8;
 constexpr size_t LED_BYTES = (LED_COUNT + 7) / 8;
 
+// 32-Bit-Woerter fuer wortweise Bit-Operationen (100 Bits → 4 Woerter)
+constexpr size_t BTN_WORDS = (BTN_BYTES + 3) / 4;
+
 // -----------------------------------------------------------------------------
 // Pin-Zuordnung (XIAO ESP32-S3)
 // -----------------------------------------------------------------------------
@@ -46,9 +55,44 @@ constexpr int PIN_LED_OE = D2;    // 74HC595: Output Enable (PWM, active-low)
 // Muss kürzer als DEBOUNCE_MS sein, damit Entprellung funktioniert.
 constexpr uint32_t IO_PERIOD_MS = 5;
 
+// IO_TIMER_SCAN: IO-Zyklus per Hardware-Timer statt vTaskDelayUntil()
+// false: FreeRTOS-Tick, Periode = IO_PERIOD_MS (mindestens 1 Tick = 1 ms)
+// true:  Timer-ISR weckt den IO-Task per Task-Notification,
+//        Periode = IO_TIMER_PERIOD_US (z.B. 250 us bis 5 ms)
+// Kürzere Periode senkt die Abtastverzögerung (SPEC: bis zu 5 ms).
+// Untergrenze: Der Zyklus muss in die Periode passen (siehe STATUS/IOLOAD).
+constexpr bool IO_TIMER_SCAN = false;
+constexpr uint32_t IO_TIMER_PERIOD_US = 1000;
+
+// Effektive Zykluszeit (Budget, Jitter, Entprell-Samples)
+constexpr uint32_t IO_PERIOD_US =
+    IO_TIMER_SCAN ? IO_TIMER_PERIOD_US : IO_PERIOD_MS * 1000;
+
+// IO_PIPELINED: Zweistufige IO-Pipeline (erfordert SCAN_FULL_DUPLEX)
+// Stufe 1: Transfer für Frame N+1 starten (mit SPI_BACKEND_DMA im Hintergrund)
+// Stufe 2: Entprellen/Auswahl/Log für Frame N, danach Transfer abholen
+// Latenz: Abtastung -> Event höchstens +1 Zyklus (IO_PERIOD_MS).
+constexpr bool IO_PIPELINED = false;
+
 // DEBOUNCE_MS: Zeit, die ein Taster stabil sein muss (30 ms = sicher)
 constexpr uint32_t DEBOUNCE_MS = 30;
 
+// DEBOUNCE_VERTICAL: Entprell-Engine waehlen
+// false: Zeitbasiert (Debouncer, ein Timer pro Taster)
+// true:  Vertikaler Zaehler (VerticalDebouncer, Bit-Planes ueber 32-Bit-Woerter)
+// Beide liefern bei festem IO_PERIOD_MS identische PRESS/RELEASE-Zeitpunkte
+// (mit IO_TIMER_SCAN nur bei IO_TIMER_PERIOD_US in ganzen ms).
+constexpr bool DEBOUNCE_VERTICAL = false;
+
+// DEBOUNCE_EAGER: Leading-Edge-Entprellung (Start-Modus, nur Debouncer)
+// false: Press und Release erst nach DEBOUNCE_MS Stabilität
+// true:  Press sofort beim ersten Roh-Wechsel, danach wird der Taster für
+//        DEBOUNCE_LOCKOUT_MS ignoriert (Prellen erzeugt kein Doppel-Event).
+//        Release bleibt zeitbasiert bestätigt.
+// Zur Laufzeit umschaltbar per Befehl "DEBOUNCE EAGER" / "DEBOUNCE CONFIRM".
+constexpr bool DEBOUNCE_EAGER = false;
+constexpr uint32_t DEBOUNCE_LOCKOUT_MS = 50;
+
 // -----------------------------------------------------------------------------
 // Selection-Verhalten
 // -----------------------------------------------------------------------------
@@ -67,6 +111,66 @@ constexpr uint32_t SPI_HZ_LED = 1000000UL; // 1 MHz
 constexpr uint8_t SPI_MODE_BTN = SPI_MODE1;
 constexpr uint8_t SPI_MODE_LED = SPI_MODE0;
 
+// SCAN_FULL_DUPLEX: Taster lesen und LEDs schreiben in EINER Transaktion
+// MOSI schiebt den LED-Frame in die 74HC595, MISO liest gleichzeitig die
+// CD4021B-Kette, danach ein Latch. Halbiert die Buszeit pro Zyklus und
+// ersetzt das 0x00-Takten (siehe LED-Update Policy unten).
+//
+// MODE0 für beide: Der 74HC595 übernimmt bei steigender Flanke. Der
+// CD4021B schiebt zwar ebenfalls bei steigender Flanke, sein Ausgang
+// reagiert aber erst nach > 100 ns - gesampelt wird also noch das alte Bit.
+// Bit 1 kommt damit direkt per SPI (keine First-Bit-Korrektur nötig).
+constexpr bool SCAN_FULL_DUPLEX = false;
+constexpr uint32_t SPI_HZ_SCAN = SPI_HZ_BTN; // langsamerer Chip bestimmt Takt
+constexpr uint8_t SPI_MODE_SCAN = SPI_MODE0;
+
+// Länge des Full-Duplex-Frames (längere der beiden Ketten)
+constexpr size_t SCAN_BYTES = (BTN_BYTES > LED_BYTES) ? BTN_BYTES : LED_BYTES;
+
+// SPI_BACKEND_DMA: SPI-Backend wählen (Build-Option, siehe platformio.ini)
+// 0: Arduino SPI-Klasse (Standard, ein blockierender Aufruf pro Transfer)
+// 1: ESP-IDF spi_master mit DMA-Puffern und Queued Transactions.
+//    Der Transfer läuft im Hintergrund, der IO-Task blockiert nur im
+//    Semaphore-Wait (kein Busy-Wait) und kann vorher Logik rechnen.
+// Als Makro, weil driver/spi_master.h nur auf dem Target existiert.
+#ifndef SPI_BACKEND_DMA
+#define SPI_BACKEND_DMA 0
+#endif
+
+// NATIVE_SIM: Host-Build ohne Hardware (env:native, Shim in sim/)
+// 1: IO-Zyklus ist per io_sim_cycle() einzeln aufrufbar, Uhr und
+//    Schieberegister sind simuliert. Auf dem Target immer 0.
+#ifndef NATIVE_SIM
+#define NATIVE_SIM 0
+#endif
+
+// -----------------------------------------------------------------------------
+// GPIO-Pulse (pro Board-Revision)
+// -----------------------------------------------------------------------------
+// P/S und RCK werden per Registerzugriff getaktet (hal/fast_gpio.h), die
+// Pulsbreiten per CPU-Zyklenzähler eingehalten. Datenblatt bei 5 V:
+// CD4021B P/S-Puls ≥ 160 ns, P/S-Removal ≥ 280 ns; 74HC595 RCK ≥ 20 ns.
+//
+// BOARD_REV: Build-Option (z.B. -DBOARD_REV=2)
+// 1: Prototyp/Breadboard (lange Leitungen, 3.3 V → großzügige Reserve)
+// 2: PCB (kurze Leitungen, Datenblattwerte + Reserve)
+#ifndef BOARD_REV
+#define BOARD_REV 1
+#endif
+
+#if BOARD_REV >= 2
+constexpr uint32_t BTN_PS_PULSE_NS = 250;  // P/S HIGH: Parallel Load
+constexpr uint32_t BTN_PS_SETTLE_NS = 300; // P/S LOW → erster Clock/Q8 lesen
+constexpr uint32_t LED_RCK_PULSE_NS = 30;  // RCK HIGH: Latch
+#else
+constexpr uint32_t BTN_PS_PULSE_NS = 400;
+constexpr uint32_t BTN_PS_SETTLE_NS = 400;
+constexpr uint32_t LED_RCK_PULSE_NS = 60;
+#endif
+
+// GPIO_FAST_PATH: false = digitalWrite() + delayMicroseconds() (Fallback)
+constexpr bool GPIO_FAST_PATH = true;
+
 // -----------------------------------------------------------------------------
 // PWM für LED-Helligkeit
 // -----------------------------------------------------------------------------
@@ -90,6 +194,60 @@ constexpr bool SERIAL_PROTOCOL_ONLY =
 constexpr bool SERIAL_SEND_READY = true;   // "READY" beim Start
 constexpr bool SERIAL_SEND_FW_LINE = true; // "FW ..." beim Start
 
+// SERIAL_TX_COALESCE: Ganze Zeilen in 64-Byte USB-Pakete packen
+// true:  ein flush() pro Paket, kein Delay (STATUS < 1 ms statt > 12 ms)
+// false: alter Pfad, flush() + 2 ms pro Zeile (max. ca. 500 Zeilen/s)
+constexpr bool SERIAL_TX_COALESCE = true;
+
+// SERIAL_TX_IDLE_MS: Leerlauf bis zum Senden eines angefangenen Pakets
+// 0: senden sobald der Stream-Buffer leer ist (geringste Latenz)
+// >0: auf weitere Events warten (weniger Pakete, +Latenz)
+constexpr uint32_t SERIAL_TX_IDLE_MS = 0;
+
+// SERIAL_TX_BUF_LEN: Stream-Buffer Serial-Task → TX-Task (Bytes)
+// 512: ca. 45 PRESS-Zeilen oder 4 komplette STATUS-Antworten
+constexpr size_t SERIAL_TX_BUF_LEN = 512;
+
+// SERIAL_TX_STALL_MS: Max. Wartezeit auf Platz im Stream-Buffer, danach
+// wird die Zeile verworfen (Zähler: STATUS/TXQ). Host liest nicht → kein
+// Hängen des Serial-Tasks
+constexpr uint32_t SERIAL_TX_STALL_MS = 20;
+
+// SERIAL_RX_EVENTS: USB-CDC RX-Callback weckt den Serial-Task
+// true:  Befehl wird sofort geparst (Latenz = Parse-Zeit)
+// false: Polling alle SERIAL_RX_POLL_MS (bis 10 ms Verzögerung)
+constexpr bool SERIAL_RX_EVENTS = true;
+
+// SERIAL_RX_POLL_MS: Max. Schlafzeit des Serial-Tasks ohne Notification
+// Mit RX-Callback nur Rückfallebene (verpasstes Event), daher länger
+constexpr uint32_t SERIAL_RX_POLL_MS = SERIAL_RX_EVENTS ? 100 : 10;
+
+// SERIAL_ACK_PENDING: Max. LED-Befehle, deren Bestätigung auf den Latch
+// wartet (getaggt "#n LEDSET 005" bzw. Binär-LED-Befehle)
+// Voll: Serial-Task wartet auf den IO-Task (Gegendruck bis zum Host)
+constexpr uint8_t SERIAL_ACK_PENDING = 32;
+
+// SERIAL_RX_LINE_LEN: Max. Länge einer Befehlszeile inkl. '\0'
+// Batch-Zeilen ("LEDCLR;LEDON 003;...") brauchen mehr als einzelne Befehle
+constexpr size_t SERIAL_RX_LINE_LEN = 256;
+
+// SERIAL_BATCH_MAX: Max. Einträge pro Batch (Fehler-Bitmap 32 Bit)
+constexpr uint8_t SERIAL_BATCH_MAX = 32;
+
+// SERIAL_BATCH_TIMEOUT_MS: Offener BEGIN-Block ohne neue Zeile wird verworfen
+// Sonst würde nach einem abgebrochenen Block (Pi neu gestartet) jeder
+// folgende LED-Befehl nur gesammelt statt angezeigt
+constexpr uint32_t SERIAL_BATCH_TIMEOUT_MS = 1000;
+
+// SERIAL_TIME_SAMPLES: Messungen im Fenster des Uhrabgleichs (TIME t1 t2 t3)
+// Offset aus der Messung mit kürzester Round-Trip-Zeit, Drift per
+// Regression über das Fenster. Mehr Messungen: ruhigere Drift, träger.
+constexpr uint8_t SERIAL_TIME_SAMPLES = 8;
+
+// SERIAL_TIME_RESET_US: Sprung gegenüber der Vorhersage, ab dem das Fenster
+// verworfen wird (Pi neu gestartet, anderer Host)
+constexpr uint32_t SERIAL_TIME_RESET_US = 1000000;
+
 // -----------------------------------------------------------------------------
 // Debug-Logging
 // -----------------------------------------------------------------------------
@@ -97,8 +255,21 @@ constexpr bool SERIAL_SEND_FW_LINE = true; // "FW ..." beim Start
 // LOG_ON_RAW_CHANGE:  Auch unentprellte Änderungen loggen (zeigt Prellen)
 constexpr bool LOG_VERBOSE_PER_ID = false;
 constexpr bool LOG_ON_RAW_CHANGE = false;
-constexpr uint8_t LOG_QUEUE_LEN =
-    32; // größer: weniger Drop-Risiko bei Burst-Events
+// LOG_QUEUE_LEN: Plätze im Event-Ring IO → Serial (Zweierpotenz)
+// Ein Event = 12 Bytes (Typ, ID, µs-Zeitstempel, Laufnummer, Roh-Flanke)
+// größer: weniger Drop-Risiko bei Burst-Events (Verluste: STATUS/LOGQ)
+constexpr uint8_t LOG_QUEUE_LEN = 32;
+
+// LOG_SNAPSHOT_LEN: Plätze für volle Zustands-Snapshots (nur Debug-Modus,
+// SERIAL_PROTOCOL_ONLY=false). Im Protokoll-Modus ungenutzt.
+constexpr uint8_t LOG_SNAPSHOT_LEN = 16;
+
+// IO_PERF_STATS: Laufzeit pro IO-Schritt (0-5) per CCOUNT, als Histogramm
+// (min/avg/p99/max), dazu Wakeup-Abweichung vom idealen IO_PERIOD_US-Raster.
+// Abfrage + Reset per Befehl PERF. Kosten: ca. 8 CCOUNT-Lesungen pro Zyklus,
+// ca. 6,5 KB RAM (Histogramme + Kopie für PERF).
+// false: Messcode entfällt, PERF antwortet mit ERROR NOT_SUPPORTED.
+constexpr bool IO_PERF_STATS = true;
 
 // -----------------------------------------------------------------------------
 // FreeRTOS-Konfiguration
@@ -109,8 +280,10 @@ constexpr BaseType_t CORE_APP = 1;
 
 // IO hoch: harter 200 Hz Zyklus, soll jitterarm bleiben
 // Serial niedriger: darf drosseln, darf IO nicht stören
+// TX am niedrigsten: blockiert im USB-Stack, Befehle/Events gehen vor
 constexpr UBaseType_t PRIO_IO = 5;
 constexpr UBaseType_t PRIO_SERIAL = 2;
+constexpr UBaseType_t PRIO_TX = 1;
 
 // -----------------------------------------------------------------------------
 // LED-Update Policy
@@ -120,9 +293,21 @@ constexpr UBaseType_t PRIO_SERIAL = 2;
 // Latch). Wenn RCK (Latch) sporadisch glitcht, können LEDs ausgehen. Refresh
 // pro Zyklus stellt den korrekten Zustand spätestens nach IO_PERIOD_MS wieder
 // her.
+// Mit SCAN_FULL_DUPLEX=true entfällt das Problem: Jeder Scan schiebt den
+// echten LED-Frame, der Refresh ist damit implizit (Flag wird ignoriert).
 constexpr bool LED_REFRESH_EVERY_CYCLE = true;
 
 static_assert(PWM_DUTY_PERCENT <= 100, "PWM_DUTY_PERCENT must be 0..100");
+static_assert(PANEL_SIZE > 0 && PANEL_SIZE <= 255, "PANEL_SIZE must be 1..255");
 static_assert(BTN_COUNT > 0 && LED_COUNT > 0, "BTN/LED count must be > 0");
+static_assert(!IO_PIPELINED || SCAN_FULL_DUPLEX,
+              "IO_PIPELINED requires SCAN_FULL_DUPLEX");
+static_assert(!(DEBOUNCE_EAGER && DEBOUNCE_VERTICAL),
+              "DEBOUNCE_EAGER requires the time-based Debouncer");
+static_assert(DEBOUNCE_LOCKOUT_MS >= DEBOUNCE_MS,
+              "DEBOUNCE_LOCKOUT_MS must cover the bounce time");
+static_assert(IO_PERIOD_US >= 250, "IO period below 250 us not supported");
+static_assert(IO_PERIOD_US < DEBOUNCE_MS * 1000,
+              "IO period must be shorter than DEBOUNCE_MS");
 
 #endif // CONFIG_H
@@ -0,0 +1,134 @@
+/**
+ * @file perf_hist.h
+ * @brief Histogramm mit festen Buckets fuer Laufzeitmessungen (CPU-Takte)
+ *
+ * Warum kein Mittelwert/Maximum allein (wie STATUS/IOLOAD)?
+ * - Seltene Ausreisser (p99) verschwinden im Mittelwert
+ * - Das Maximum sagt nicht, wie oft es passiert
+ *
+ * Hier:
+ * - Log-linear: 4 Buckets pro Zweierpotenz (Fehler <= 25 %)
+ * - add() ohne Division und ohne Schleife (clz + Shift), kein Heap
+ * - Min/Max/Summe exakt, Perzentile auf Bucket-Genauigkeit
+ *
+ * Nicht thread-sicher: Genau ein Schreiber; Auslesen per Kopie, die der
+ * Schreiber selbst anlegt (siehe io_get_perf()).
+ */
+#ifndef PERF_HIST_H
+#define PERF_HIST_H
+
+// =============================================================================
+// INCLUDES
+// =============================================================================
+
+#include <stddef.h>
+#include <stdint.h>
+
+// =============================================================================
+// CLASSES
+// =============================================================================
+
+/**
+ * @brief Log-lineares Histogramm fuer uint32-Messwerte
+ *
+ * Bucket 0..3 = Werte 0..3, danach 4 Buckets pro Zweierpotenz bis ca.
+ * 2^25 (bei 240 MHz ca. 120 ms). Groessere Werte landen im letzten Bucket,
+ * max() bleibt exakt.
+ */
+class PerfHist {
+public:
+    static constexpr size_t SUB_BITS = 2;
+    static constexpr size_t SUB_COUNT = 1u << SUB_BITS;
+    static constexpr size_t BUCKETS = 96;
+
+    /**
+     * @brief Verbucht einen Messwert
+     * @param value Messwert (z.B. CPU-Takte)
+     */
+    void add(uint32_t value) {
+        _counts[bucket_of(value)]++;
+        _count++;
+        _sum += value;
+        if (value < _min) {
+            _min = value;
+        }
+        if (value > _max) {
+            _max = value;
+        }
+    }
+
+    /**
+     * @brief Setzt alle Zaehler zurueck (neues Messfenster)
+     */
+    void reset() { *this = PerfHist(); }
+
+    uint32_t count() const { return _count; }
+    uint32_t min() const { return _count > 0 ? _min : 0; }
+    uint32_t max() const { return _max; }
+
+    uint32_t avg() const {
+        return _count > 0 ? static_cast<uint32_t>(_sum / _count) : 0;
+    }
+
+    /**
+     * @brief Perzentil als Obergrenze des Buckets (pessimistisch)
+     * @param permille Perzentil in Promille (990 = p99)
+     * @return Wert, unter dem mindestens permille/1000 der Messungen liegen
+     */
+    uint32_t percentile(uint32_t permille) const {
+        if (_count == 0) {
+            return 0;
+        }
+        // Rang aufrunden: p99 von 10 Werten ist der groesste
+        const uint64_t rank =
+            (static_cast<uint64_t>(_count) * permille + 999) / 1000;
+        uint64_t seen = 0;
+        for (size_t i = 0; i < BUCKETS; i++) {
+            seen += _counts[i];
+            if (seen >= rank && seen > 0) {
+                const uint32_t upper = bucket_upper(i);
+                return upper < _max ? upper : _max;
+            }
+        }
+        return _max;
+    }
+
+    /**
+     * @brief Bucket-Index eines Werts
+     */
+    static size_t bucket_of(uint32_t value) {
+        if (value < SUB_COUNT) {
+            return value;
+        }
+        const uint32_t msb = 31u - static_cast<uint32_t>(__builtin_clz(value));
+        const size_t index = (msb - SUB_BITS + 1) * SUB_COUNT +
+                             ((value >> (msb - SUB_BITS)) & (SUB_COUNT - 1));
+        return index < BUCKETS ? index : BUCKETS - 1;
+    }
+
+    /**
+     * @brief Groesster Wert, der noch in Bucket index faellt
+     */
+    static uint32_t bucket_upper(size_t index) {
+        if (index < SUB_COUNT) {
+            return static_cast<uint32_t>(index);
+        }
+        if (index >= BUCKETS - 1) {
+            return UINT32_MAX; // Ueberlauf-Bucket
+        }
+        const uint32_t shift =
+            static_cast<uint32_t>(index / SUB_COUNT - 1); // msb - SUB_BITS
+        const uint32_t lower =
+            static_cast<uint32_t>(SUB_COUNT + index % SUB_COUNT) << shift;
+        return lower + (1u << shift) - 1;
+    }
+
+private:
+    uint32_t _counts[BUCKETS] = {}; /**< Treffer pro Bucket */
+    uint32_t _count = 0;            /**< Anzahl Messungen */
+    uint64_t _sum = 0;              /**< Summe (fuer den Mittelwert) */
+    uint32_t _min = UINT32_MAX;     /**< Kleinster Wert */
+    uint32_t _max = 0;              /**< Groesster Wert */
+};
+
+#endif // PERF_HIST_H
@@ -0,0 +1,85 @@
+/**
+ * @file seqlock.h
+ * @brief Seqlock fuer genau einen Schreiber: immer nur der neueste Wert
+ *
+ * Warum nicht xQueueSend()?
+ * - Queue mit fester Tiefe verwirft Befehle bei Bursts stillschweigend
+ * - Der Leser spielt jeden Zwischenzustand einzeln nach
+ *
+ * Hier:
+ * - Schreiber kopiert den kompletten Wert, Zaehler ungerade = Schreiben laeuft
+ * - Leser kopiert und prueft den Zaehler davor/danach (keine Locks)
+ * - Last-Writer-Wins: Zwischenstaende werden ueberschrieben, nie verworfen
+ *
+ * Der Leser wartet nie: Ein halb geschriebener Wert wird ausgelassen und
+ * beim naechsten Aufruf abgeholt. Wichtig, wenn der Leser (IO-Task) eine
+ * hoehere Prioritaet als der Schreiber hat und ihn unterbrochen haben kann.
+ */
+#ifndef SEQLOCK_H
+#define SEQLOCK_H
+
+// =============================================================================
+// INCLUDES
+// =============================================================================
+
+#include <atomic>
+#include <stdint.h>
+
+// =============================================================================
+// CLASSES
+// =============================================================================
+
+/**
+ * @brief Seqlock mit einem Schreiber und einem Leser
+ * @tparam T Werttyp (trivial kopierbar)
+ */
+template <typename T>
+class Seqlock {
+public:
+    /**
+     * @brief Veroeffentlicht einen neuen Wert (nur Schreiber)
+     * @param value Wert (wird kopiert)
+     */
+    void write(const T& value) {
+        const uint32_t seq = _seq.load(std::memory_order_relaxed);
+        _seq.store(seq + 1, std::memory_order_relaxed); // ungerade: in Arbeit
+        std::atomic_thread_fence(std::memory_order_release);
+        _value = value;
+        _seq.store(seq + 2, std::memory_order_release);
+    }
+
+    /**
+     * @brief Liest den Wert, falls seit dem letzten Lesen neu (nur Leser)
+     * @param out Ziel
+     * @param seen Zaehlerstand des zuletzt gelesenen Werts (wird aktualisiert)
+     * @return false wenn nichts Neues oder gerade geschrieben wird
+     */
+    bool read(T& out, uint32_t& seen) const {
+        const uint32_t before = _seq.load(std::memory_order_acquire);
+        if (before == seen || (before & 1u) != 0) {
+            return false;
+        }
+
+        out = _value;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (_seq.load(std::memory_order_relaxed) != before) {
+            return false; // Schreiber dazwischen: naechster Versuch
+        }
+
+        seen = before;
+        return true;
+    }
+
+    /**
+     * @brief Anzahl veroeffentlichter Werte seit Start
+     */
+    uint32_t writes() const {
+        return _seq.load(std::memory_order_relaxed) / 2;
+    }
+
+private:
+    T _value = {};                  /**< Zuletzt veroeffentlichter Wert */
+    std::atomic<uint32_t> _seq{0};  /**< Gerade = stabil, ungerade = in Arbeit */
+};
+
+#endif // SEQLOCK_H
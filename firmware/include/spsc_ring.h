@@ -0,0 +1,113 @@
+/**
+ * @file spsc_ring.h
+ * @brief Lock-freier Ringpuffer fuer genau einen Producer und einen Consumer
+ *
+ * Warum nicht xQueueSend()?
+ * - Jede Queue-Operation laeuft durch den Kernel (Critical Section)
+ * - Volle Queue verwirft Events stillschweigend
+ *
+ * Hier:
+ * - Producer schreibt nur _head, Consumer nur _tail (keine Locks)
+ * - Acquire/Release-Ordnung: Element ist geschrieben, bevor _head es freigibt
+ * - Overflow-Zaehler und High-Water-Mark statt stiller Verluste
+ *
+ * Wecken des Consumers ist Sache des Aufrufers (z.B. Task-Notification).
+ */
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+// =============================================================================
+// INCLUDES
+// =============================================================================
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+// =============================================================================
+// CLASSES
+// =============================================================================
+
+/**
+ * @brief SPSC-Ringpuffer mit fester Kapazitaet
+ * @tparam T Elementtyp (trivial kopierbar)
+ * @tparam N Kapazitaet (Zweierpotenz)
+ */
+template <typename T, size_t N>
+class SpscRing {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "N must be a power of two");
+
+public:
+    static constexpr size_t CAPACITY = N;
+
+    /**
+     * @brief Legt ein Element ab (nur Producer)
+     * @param item Element (wird kopiert)
+     * @return false wenn voll (Overflow wird gezaehlt)
+     */
+    bool push(const T& item) {
+        const uint32_t head = _head.load(std::memory_order_relaxed);
+        const uint32_t used = head - _tail.load(std::memory_order_acquire);
+
+        if (used >= N) {
+            _overflows.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        _buf[head & (N - 1)] = item;
+        _head.store(head + 1, std::memory_order_release);
+
+        // High-Water-Mark: nur der Producer schreibt
+        if (used + 1 > _high_water.load(std::memory_order_relaxed)) {
+            _high_water.store(used + 1, std::memory_order_relaxed);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Entnimmt das aelteste Element (nur Consumer)
+     * @param out Ziel
+     * @return false wenn leer
+     */
+    bool pop(T& out) {
+        const uint32_t tail = _tail.load(std::memory_order_relaxed);
+        if (tail == _head.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        out = _buf[tail & (N - 1)];
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Aktueller Fuellstand (Momentaufnahme)
+     */
+    size_t size() const {
+        return _head.load(std::memory_order_acquire) -
+               _tail.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Verworfene Elemente seit Start (Ring voll)
+     */
+    uint32_t overflows() const {
+        return _overflows.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Hoechster Fuellstand seit Start
+     */
+    uint32_t highWater() const {
+        return _high_water.load(std::memory_order_relaxed);
+    }
+
+private:
+    T _buf[N] = {};                         /**< Elemente */
+    std::atomic<uint32_t> _head{0};         /**< Schreibindex (Producer) */
+    std::atomic<uint32_t> _tail{0};         /**< Leseindex (Consumer) */
+    std::atomic<uint32_t> _overflows{0};    /**< Verworfene Elemente */
+    std::atomic<uint32_t> _high_water{0};   /**< Max. Fuellstand */
+};
+
+#endif // SPSC_RING_H
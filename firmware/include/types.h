@@ -11,7 +11,9 @@
 // INCLUDES
 // =============================================================================
 
+#include "bitops.h"
 #include "config.h"
+#include "spsc_ring.h"
 #include <Arduino.h>
 
 // =============================================================================
@@ -19,20 +21,58 @@
 // =============================================================================
 
 /**
- * @brief Snapshot des Systemzustands fuer die Queue zwischen IO und Serial.
+ * @brief Typ eines Events im Event-Ring
+ */
+typedef enum io_event_type {
+    IO_EVT_PRESS,   /**< Taster entprellt gedrueckt (id = Taster) */
+    IO_EVT_RELEASE, /**< Taster entprellt losgelassen (id = Taster) */
+    IO_EVT_ACTIVE,  /**< Auswahl geaendert (id = neue Auswahl, 0 = keine) */
+    IO_EVT_LED      /**< LED-Frame gelatcht (id = Ack-Nummer, us = Latch) */
+} io_event_type_e;
+
+/**
+ * @brief Kompaktes Event fuer den Ring zwischen IO und Serial.
+ *
+ * Feste 12 Bytes, unabhaengig von BTN_COUNT/LED_COUNT.
+ * Luecken in seq zeigen verworfene Events an. Bei PRESS/ACTIVE ist seq
+ * zugleich die Korrelations-ID fuer die Latenz-Messung (TRACE ON).
+ */
+typedef struct io_event {
+    uint32_t us;      /**< Zeitstempel der Abtastung (micros()) */
+    uint16_t seq;     /**< Laufnummer (pro Event +1, auch bei Verlust) */
+    uint8_t type;     /**< io_event_type_e */
+    uint8_t id;       /**< Taster-/LED-ID (1-basiert, 0 = keine) */
+    uint32_t edge_us; /**< Erste Roh-Flanke (PRESS/ACTIVE), sonst 0 */
+} io_event_t;
+
+static_assert(sizeof(io_event_t) == 12, "io_event_t must stay 12 bytes");
+
+/**
+ * @brief Snapshot des Systemzustands (nur Debug-Ausgabe).
  *
- * Ein Queue-Element = ein atomarer Snapshot.
+ * Ein Ring-Element = ein atomarer Snapshot.
  * Keine Race-Conditions zwischen Feldern.
  */
 typedef struct log_event {
-    uint32_t ms;            /**< Zeitstempel (fuer Debugging) */
-    uint8_t raw[BTN_BYTES]; /**< Rohzustand der Taster */
-    uint8_t deb[BTN_BYTES]; /**< Entprellter Zustand */
-    uint8_t led[LED_BYTES]; /**< LED-Ausgabezustand */
-    uint8_t active_id;      /**< Aktive Auswahl (0 = keine, 1-10 = ID) */
-    bool raw_changed;       /**< Flag: Raw hat sich geaendert */
-    bool deb_changed;       /**< Flag: Debounced hat sich geaendert */
-    bool active_changed;    /**< Flag: Auswahl hat sich geaendert */
+    uint32_t ms;         /**< Zeitstempel (fuer Debugging) */
+    btn_bits_t raw;      /**< Rohzustand der Taster */
+    btn_bits_t deb;      /**< Entprellter Zustand */
+    led_bits_t led;      /**< LED-Ausgabezustand */
+    uint8_t active_id;   /**< Aktive Auswahl (0 = keine, 1-10 = ID) */
+    bool raw_changed;    /**< Flag: Raw hat sich geaendert */
+    bool deb_changed;    /**< Flag: Debounced hat sich geaendert */
+    bool active_changed; /**< Flag: Auswahl hat sich geaendert */
 } log_event_t;
 
+/**
+ * @brief Log-Kanal IO-Task (Producer) -> Serial-Task (Consumer)
+ *
+ * events:    Kompakte Events, immer aktiv
+ * snapshots: Volle Zustaende, nur im Debug-Modus befuellt
+ */
+typedef struct log_channel {
+    SpscRing<io_event_t, LOG_QUEUE_LEN> events;
+    SpscRing<log_event_t, LOG_SNAPSHOT_LEN> snapshots;
+} log_channel_t;
+
 #endif // TYPES_H
@@ -0,0 +1,95 @@
+/**
+ * @file Arduino.h
+ * @brief Host-Shim fuer Arduino-ESP32 (nur env:native)
+ *
+ * Deckt genau das ab, was IO-Pfad, Treiber-Header und config.h nutzen.
+ * Zeit ist simuliert (sim_clock.h): millis()/micros() laufen nur, wenn
+ * vTaskDelayUntil() oder delay() sie vorstellen. Damit laeuft ein IO-Zyklus
+ * so schnell, wie der Host rechnet, und ist reproduzierbar.
+ */
+#ifndef SIM_ARDUINO_H
+#define SIM_ARDUINO_H
+
+// =============================================================================
+// INCLUDES
+// =============================================================================
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+#include "sim_clock.h"
+
+// =============================================================================
+// KONSTANTEN
+// =============================================================================
+
+#define F_CPU 240000000L
+#define IRAM_ATTR
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+
+// XIAO ESP32-S3 Pin-Namen (Werte wie im Board-Paket)
+#define D0 1
+#define D1 2
+#define D2 3
+#define D8 7
+#define D9 8
+#define D10 9
+
+// =============================================================================
+// ZEIT (simuliert)
+// =============================================================================
+
+static inline uint32_t millis() {
+    return static_cast<uint32_t>(sim_clock_us() / 1000);
+}
+
+static inline uint32_t micros() {
+    return static_cast<uint32_t>(sim_clock_us());
+}
+
+static inline void delay(uint32_t ms) { sim_clock_advance_us(ms * 1000ULL); }
+
+static inline void delayMicroseconds(uint32_t us) { sim_clock_advance_us(us); }
+
+// =============================================================================
+// GPIO / PWM (ohne Wirkung, Schieberegister sind in sim_hal.cpp modelliert)
+// =============================================================================
+
+static inline void pinMode(int, int) {}
+static inline void digitalWrite(int, int) {}
+static inline int digitalRead(int) { return HIGH; }
+static inline void ledcSetup(int, uint32_t, int) {}
+static inline void ledcAttachPin(int, int) {}
+static inline void ledcWrite(int, uint32_t) {}
+
+// =============================================================================
+// ESP / TIMER
+// =============================================================================
+
+/**
+ * @brief Ersatz fuer ESP: CCOUNT aus der simulierten Uhr (240 MHz)
+ */
+class EspClass {
+public:
+    uint32_t getCycleCount() {
+        return static_cast<uint32_t>(sim_clock_us() * (F_CPU / 1000000L));
+    }
+    uint32_t getCpuFreqMHz() { return F_CPU / 1000000L; }
+    uint32_t getFreeHeap() { return 0; }
+};
+
+extern EspClass ESP;
+
+// Nur als Handle (ScanTimer-Member), Timer selbst in sim_hal.cpp
+typedef struct hw_timer_s hw_timer_t;
+
+#endif // SIM_ARDUINO_H
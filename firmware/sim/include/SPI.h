@@ -0,0 +1,29 @@
+/**
+ * @file SPI.h
+ * @brief Host-Shim fuer die Arduino-SPI-Klasse (nur env:native)
+ *
+ * Nur die Konstanten fuer config.h. Die Transfers modelliert SpiBus in
+ * sim_hal.cpp direkt auf den Schieberegistern.
+ */
+#ifndef SIM_SPI_H
+#define SIM_SPI_H
+
+// =============================================================================
+// INCLUDES
+// =============================================================================
+
+#include <stdint.h>
+
+// =============================================================================
+// KONSTANTEN
+// =============================================================================
+
+#define SPI_MODE0 0
+#define SPI_MODE1 1
+#define SPI_MODE2 2
+#define SPI_MODE3 3
+
+#define SPI_MSBFIRST 1
+#define MSBFIRST 1
+
+#endif // SIM_SPI_H
@@ -0,0 +1,57 @@
+/**
+ * @file FreeRTOS.h
+ * @brief Host-Shim fuer FreeRTOS-Typen (nur env:native)
+ *
+ * Kein Scheduler: Die Simulation ruft den IO-Zyklus direkt auf, es gibt
+ * genau einen Thread. Kritische Abschnitte sind daher leer.
+ * 1 Tick = 1 ms (wie configTICK_RATE_HZ auf dem Target).
+ */
+#ifndef SIM_FREERTOS_H
+#define SIM_FREERTOS_H
+
+// =============================================================================
+// INCLUDES
+// =============================================================================
+
+#include <stddef.h>
+#include <stdint.h>
+
+// =============================================================================
+// TYPES
+// =============================================================================
+
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t TickType_t;
+
+typedef struct sim_queue *QueueHandle_t;
+typedef struct sim_queue *SemaphoreHandle_t;
+typedef struct sim_task *TaskHandle_t;
+typedef void (*TaskFunction_t)(void *);
+
+typedef struct {
+    uint32_t owner;
+} portMUX_TYPE;
+
+// =============================================================================
+// KONSTANTEN
+// =============================================================================
+
+#define pdTRUE 1
+#define pdFALSE 0
+#define pdPASS 1
+#define pdFAIL 0
+
+#define configTICK_RATE_HZ 1000
+#define portTICK_PERIOD_MS 1
+#define portMAX_DELAY 0xFFFFFFFFu
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+
+#define tskNO_AFFINITY 0x7FFFFFFF
+
+#define portMUX_INITIALIZER_UNLOCKED {0}
+#define portENTER_CRITICAL(mux) ((void)(mux))
+#define portEXIT_CRITICAL(mux) ((void)(mux))
+#define portYIELD_FROM_ISR(woken) ((void)(woken))
+
+#endif // SIM_FREERTOS_H
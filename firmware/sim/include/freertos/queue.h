@@ -0,0 +1,30 @@
+/**
+ * @file queue.h
+ * @brief Host-Shim fuer FreeRTOS-Queues (nur env:native)
+ *
+ * Ringpuffer mit fester Tiefe und Elementgroesse wie auf dem Target.
+ * Ohne Scheduler gibt es niemanden, auf den man warten koennte: Wartezeiten
+ * werden ignoriert, volle bzw. leere Queue liefert sofort pdFALSE.
+ */
+#ifndef SIM_FREERTOS_QUEUE_H
+#define SIM_FREERTOS_QUEUE_H
+
+// =============================================================================
+// INCLUDES
+// =============================================================================
+
+#include "freertos/FreeRTOS.h"
+
+// =============================================================================
+// OEFFENTLICHE FUNKTIONEN
+// =============================================================================
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t item_size);
+void vQueueDelete(QueueHandle_t queue);
+BaseType_t xQueueSend(QueueHandle_t queue, const void *item, TickType_t wait);
+BaseType_t xQueueReceive(QueueHandle_t queue, void *out, TickType_t wait);
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue);
+
+#define xQueueSendToBack(queue, item, wait) xQueueSend(queue, item, wait)
+
+#endif // SIM_FREERTOS_QUEUE_H
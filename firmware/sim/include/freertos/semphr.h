@@ -0,0 +1,24 @@
+/**
+ * @file semphr.h
+ * @brief Host-Shim fuer FreeRTOS-Mutexe (nur env:native)
+ *
+ * Mutex = Queue der Tiefe 1 ohne Nutzdaten (wie in FreeRTOS selbst).
+ */
+#ifndef SIM_FREERTOS_SEMPHR_H
+#define SIM_FREERTOS_SEMPHR_H
+
+// =============================================================================
+// INCLUDES
+// =============================================================================
+
+#include "freertos/queue.h"
+
+// =============================================================================
+// OEFFENTLICHE FUNKTIONEN
+// =============================================================================
+
+SemaphoreHandle_t xSemaphoreCreateMutex();
+BaseType_t xSemaphoreTake(SemaphoreHandle_t mutex, TickType_t wait);
+BaseType_t xSemaphoreGive(SemaphoreHandle_t mutex);
+
+#endif // SIM_FREERTOS_SEMPHR_H
@@ -0,0 +1,42 @@
+/**
+ * @file task.h
+ * @brief Host-Shim fuer FreeRTOS-Tasks (nur env:native)
+ *
+ * vTaskDelayUntil() blockiert nicht, sondern stellt die simulierte Uhr
+ * auf den naechsten Wakeup. Tasks werden nicht gestartet.
+ */
+#ifndef SIM_FREERTOS_TASK_H
+#define SIM_FREERTOS_TASK_H
+
+// =============================================================================
+// INCLUDES
+// =============================================================================
+
+#include "freertos/FreeRTOS.h"
+
+// =============================================================================
+// OEFFENTLICHE FUNKTIONEN
+// =============================================================================
+
+TickType_t xTaskGetTickCount();
+
+/**
+ * @brief Stellt die Uhr auf *prev + period (verpasste Perioden: sofort)
+ */
+void vTaskDelayUntil(TickType_t *prev, TickType_t period);
+
+void vTaskDelay(TickType_t ticks);
+
+/**
+ * @brief Kein Scheduler: liefert pdFAIL, Zyklen per io_sim_cycle()
+ */
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char *name,
+                                   uint32_t stack, void *arg,
+                                   UBaseType_t prio, TaskHandle_t *handle,
+                                   BaseType_t core);
+
+TaskHandle_t xTaskGetCurrentTaskHandle();
+BaseType_t xTaskNotifyGive(TaskHandle_t task);
+uint32_t ulTaskNotifyTake(BaseType_t clear, TickType_t wait);
+
+#endif // SIM_FREERTOS_TASK_H
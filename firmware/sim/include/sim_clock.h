@@ -0,0 +1,40 @@
+/**
+ * @file sim_clock.h
+ * @brief Simulierte Uhr fuer env:native
+ *
+ * Eine Uhr fuer alles: millis(), micros(), Tick-Zaehler und CCOUNT.
+ * Laeuft nur vorwaerts, wenn Code wartet (vTaskDelayUntil, delay) oder
+ * der Simulationstreiber sie vorstellt.
+ */
+#ifndef SIM_CLOCK_H
+#define SIM_CLOCK_H
+
+// =============================================================================
+// INCLUDES
+// =============================================================================
+
+#include <stdint.h>
+
+// =============================================================================
+// OEFFENTLICHE FUNKTIONEN
+// =============================================================================
+
+/**
+ * @brief Simulierte Zeit seit Start
+ * @return Mikrosekunden (64 Bit, kein Ueberlauf)
+ */
+uint64_t sim_clock_us();
+
+/**
+ * @brief Stellt die Uhr vor
+ * @param us Mikrosekunden
+ */
+void sim_clock_advance_us(uint64_t us);
+
+/**
+ * @brief Stellt die Uhr auf einen Zeitpunkt (nie rueckwaerts)
+ * @param us Ziel in Mikrosekunden
+ */
+void sim_clock_advance_to(uint64_t us);
+
+#endif // SIM_CLOCK_H
@@ -0,0 +1,754 @@
+/**
+ * @file main.cpp
+ * @brief Host-Simulation des IO-Pfads (env:native)
+ *
+ * Laeuft den echten IO-Zyklus (io_task.cpp, Debouncer, Selection,
+ * DuplexScan) gegen das simulierte Panel aus sim_hal.cpp:
+ * - Zufaellige Tastendruecke mit Prellen (kuerzer als DEBOUNCE_MS)
+ * - LED-Befehle vom "Pi" in den Pausen, als Zeilen durch command.cpp
+ *
+ * Geprueft wird pro Zyklus:
+ * - Laufnummern im Event-Ring lueckenlos, kein Ring-Ueberlauf
+ * - Hoechstens ein ACTIVE-Event pro Tastendruck (Prellen filtert)
+ * - Auswahl = gedrueckter Taster nach DEBOUNCE_MS, Latenz im Budget
+ * - Ausgaenge der 74HC595 = One-Hot der Auswahl bzw. befohlener Frame
+ * - Jede Ack-Nummer kommt genau einmal, in Reihenfolge, nach dem Latch
+ * - LED-Befehl gesammelt vor, committet nach einer lokalen Auswahl: Nur die
+ *   Auswahl-LED folgt der lokalen Auswahl, alle anderen Bits wie gesammelt
+ * - Erwartungen folgen config.h: DEBOUNCE_EAGER misst die Latenz ab dem
+ *   ersten Kontakt, LATCH_SELECTION = false loescht die Auswahl ohne
+ *   gedrueckten Taster
+ *
+ * Vorab (unabhaengig von DEBOUNCE_VERTICAL): Debouncer und
+ * VerticalDebouncer bekommen dieselbe prellende Roh-Spur im Takt
+ * IO_PERIOD_US und muessen in jedem Zyklus dasselbe entprellte Bitset
+ * liefern (Laeufe knapp unter, genau auf und knapp ueber der Schwelle).
+ * Nur bei IO_PERIOD_US in ganzen ms, sonst uebersprungen.
+ *
+ * Aufruf:
+ *   pio run -e native && .pio/build/native/program [zyklen] [seed]
+ * Exit-Code 1 bei Fehlern (fuer CI).
+ */
+
+// =============================================================================
+// INCLUDES
+// =============================================================================
+
+#include "config.h"
+#include "types.h"
+
+#include "app/command.h"
+#include "app/io_task.h"
+#include "logic/debounce.h"
+#include "logic/vertical_debounce.h"
+#include "sim_hal.h"
+
+#include <chrono>
+#include <random>
+
+// =============================================================================
+// KONSTANTEN
+// =============================================================================
+
+// Zyklen ohne Argument (bei 5 ms: knapp 14 h simulierte Zeit)
+constexpr uint32_t SIM_DEFAULT_CYCLES = 10000000;
+
+// Zyklen pro Entprellzeit (mindestens 1)
+constexpr uint32_t SIM_DEBOUNCE_CYCLES =
+    (DEBOUNCE_MS * 1000 + IO_PERIOD_US - 1) / IO_PERIOD_US;
+
+// Prellen: kuerzer als DEBOUNCE_MS, sonst waere es ein echter Druck
+constexpr uint32_t SIM_BOUNCE_MAX_CYCLES =
+    (SIM_DEBOUNCE_CYCLES > 1) ? SIM_DEBOUNCE_CYCLES - 1 : 0;
+
+// Latenz-Budget: Entprellzeit + Abtastraster + Pipeline-Stufe. Mit
+// DEBOUNCE_EAGER kommt ACTIVE schon beim ersten Kontakt (vor "stabil"),
+// gemessen wird dann ab dem ersten Kontakt ohne Entprellzeit.
+constexpr uint32_t SIM_LATENCY_MAX_US =
+    (DEBOUNCE_EAGER ? 0 : DEBOUNCE_MS * 1000) + 2 * IO_PERIOD_US;
+
+// Ausgabe der ersten Fehler (Rest nur gezaehlt)
+constexpr uint32_t SIM_MAX_REPORTED = 10;
+
+// Entprell-Abgleich: Zyklen (bei 100 Tastern ca. 0,1 s Host-Zeit)
+constexpr uint32_t SIM_DEBOUNCE_CHECK_CYCLES = 200000;
+
+// Feste Lauflaengen (Samples gedrueckt, losgelassen, ...) rund um die
+// Schwelle: SIM_DEBOUNCE_CYCLES wird gerade nicht, +1 gerade noch uebernommen
+constexpr uint32_t SIM_RUN_LEN = SIM_DEBOUNCE_CYCLES;
+constexpr uint32_t SIM_RUN_PATTERNS[][6] = {
+    // Druck zu kurz, Release knapp
+    {SIM_RUN_LEN, SIM_RUN_LEN + 1, SIM_RUN_LEN, SIM_RUN_LEN + 1, SIM_RUN_LEN,
+     SIM_RUN_LEN + 1},
+    // Druck knapp, Release zu kurz
+    {SIM_RUN_LEN + 1, SIM_RUN_LEN, SIM_RUN_LEN + 1, SIM_RUN_LEN,
+     SIM_RUN_LEN + 1, SIM_RUN_LEN},
+    // Prellen endet genau auf der Schwelle
+    {SIM_RUN_LEN - 1, 1, SIM_RUN_LEN + 1, 1, SIM_RUN_LEN, 2},
+    // Schnelles Prellen, dann stabil
+    {1, 1, 1, 1, SIM_RUN_LEN + 1, SIM_RUN_LEN + 1},
+    // Einzelne Ausreisser
+    {SIM_RUN_LEN + 1, 1, SIM_RUN_LEN, 1, SIM_RUN_LEN + 1, SIM_RUN_LEN + 2},
+};
+constexpr size_t SIM_RUN_PATTERN_COUNT =
+    sizeof(SIM_RUN_PATTERNS) / sizeof(SIM_RUN_PATTERNS[0]);
+
+// =============================================================================
+// TYPES
+// =============================================================================
+
+/**
+ * @brief Phase eines Tastendrucks
+ */
+typedef enum sim_phase {
+    SIM_IDLE,          /**< Pause, LED-Befehle moeglich */
+    SIM_PRESS_BOUNCE,  /**< Kontakt prellt beim Druecken */
+    SIM_HOLD,          /**< Kontakt stabil geschlossen */
+    SIM_RELEASE_BOUNCE /**< Kontakt prellt beim Loslassen */
+} sim_phase_e;
+
+/**
+ * @brief LED-Befehl zwischen Sammeln und Commit
+ */
+typedef struct sim_led_op {
+    uint8_t cmd;       /**< 0 SET, 1 ON, 2 OFF, 3 CLR, 4 ALL, 5 MASK */
+    uint8_t id;        /**< LED-ID (SET/ON/OFF) */
+    int16_t active_id; /**< Auswahl fuer CURLED (LEDSET/LEDCLR), sonst -1 */
+    char line[SERIAL_RX_LINE_LEN]; /**< Befehlszeile ohne Tag */
+} sim_led_op_t;
+
+/**
+ * @brief Zustand des Simulationstreibers
+ */
+typedef struct sim_state {
+    sim_phase_e phase;     /**< Aktuelle Phase */
+    uint32_t phase_left;   /**< Restliche Zyklen der Phase */
+    uint8_t btn;           /**< Taster des laufenden Drucks */
+    uint64_t contact_us;   /**< Zeitpunkt: erster Kontakt (0 = noch keiner) */
+    uint64_t stable_us;    /**< Zeitpunkt: Kontakt stabil geschlossen */
+    uint8_t active_events; /**< ACTIVE-Events (id != 0) in diesem Druck */
+    uint8_t active;        /**< Auswahl laut Events */
+    bool held;             /**< Laut PRESS/RELEASE entprellt gedrueckt */
+    bool local_latched;    /**< Auswahl dieses Drucks ist gelatcht */
+    uint16_t next_seq;     /**< Erwartete Event-Laufnummer */
+    uint8_t ack_sent;      /**< Zuletzt committete Ack-Nummer */
+    uint8_t ack_seen;      /**< Zuletzt bestaetigte Ack-Nummer */
+    led_bits_t led_expect; /**< Erwarteter Frame nach dem Ack */
+    uint8_t active_expect; /**< Auswahl nach dem Ack (LEDSET/LEDCLR) */
+    uint8_t sel_led;       /**< Auswahl-LED im Frame (0 = keine) */
+    bool remote;           /**< Remote-Modus laut Modell */
+    sim_led_op_t op;       /**< Zuletzt gesammelter LED-Befehl */
+    led_bits_t op_leds;    /**< Frame des gesammelten Befehls */
+    uint8_t op_active;     /**< Auswahl des gesammelten Befehls */
+    uint8_t op_sel_led;    /**< Auswahl-LED des gesammelten Befehls */
+    bool op_remote;        /**< Remote-Modus des gesammelten Befehls */
+    bool op_staged;        /**< Gesammelt, Commit nach dem ACTIVE */
+    bool op_in_press;      /**< LED-Befehl waehrend dieses Drucks */
+} sim_state_t;
+
+/**
+ * @brief Zaehler fuer den Bericht
+ */
+typedef struct sim_report {
+    uint32_t presses;     /**< Tastendruecke */
+    uint32_t led_cmds;    /**< Committete LED-Befehle */
+    uint32_t events;      /**< Gelesene Events */
+    uint32_t errors;      /**< Verletzte Pruefungen */
+    uint32_t latency_max; /**< Groesste Latenz bis ACTIVE */
+    uint64_t latency_sum; /**< Summe fuer den Mittelwert */
+    uint32_t latency_n;   /**< Anzahl Messungen */
+} sim_report_t;
+
+// =============================================================================
+// MODUL-LOKALE VARIABLEN
+// =============================================================================
+
+static log_channel_t _log_channel;
+static sim_state_t _sim = {};
+static sim_report_t _report = {};
+static uint32_t _cycle = 0;
+static std::mt19937 _rng;
+
+// Antworten von command.cpp (Rolle des Serial-Tasks)
+static char _reply[64];
+static uint32_t _replies = 0;
+static bool _expect_reply = false; // Nur waehrend send_command()
+
+// =============================================================================
+// PRIVATE HILFSFUNKTIONEN
+// =============================================================================
+
+/**
+ * @brief Zufallszahl im Bereich [lo, hi]
+ */
+static uint32_t random_range(uint32_t lo, uint32_t hi) {
+    return lo + _rng() % (hi - lo + 1);
+}
+
+/**
+ * @brief Meldet eine verletzte Pruefung
+ */
+static void fail(const char *what, uint32_t a, uint32_t b) {
+    if (_report.errors < SIM_MAX_REPORTED) {
+        printf("FEHLER Zyklus %u: %s (%u / %u)\n", (unsigned)_cycle, what,
+               (unsigned)a, (unsigned)b);
+    }
+    _report.errors++;
+}
+
+/**
+ * @brief LED-Frame als Zahl fuer Fehlermeldungen (erste 32 LEDs)
+ */
+static uint32_t led_word(const led_bits_t &leds) { return leds.word(0); }
+
+/**
+ * @brief Vergleicht zeitbasierten und vertikalen Entpreller auf einer Spur
+ *
+ * Die ersten Taster laufen feste Muster (SIM_RUN_PATTERNS, je Taster
+ * versetzt), alle weiteren zufaellige Lauflaengen 1..SIM_RUN_LEN + 2.
+ * Zeit in ms wie im IO-Task aus dem Zyklus-Raster (IO_PERIOD_US).
+ */
+static void check_debounce_engines() {
+    static_assert(SIM_RUN_LEN == DEBOUNCE_SAMPLES, "Raster uneins");
+    static_assert(SIM_RUN_LEN >= 2, "Muster brauchen DEBOUNCE_SAMPLES >= 2");
+
+    // Zeitbasiert rechnet in ganzen ms, vertikal in Samples: gleich nur bei
+    // einem Raster aus ganzen ms (siehe vertical_debounce.h)
+    if (IO_PERIOD_US % 1000 != 0) {
+        printf("Entprell-Abgleich: uebersprungen (IO_PERIOD_US = %u us)\n",
+               (unsigned)IO_PERIOD_US);
+        return;
+    }
+
+    Debouncer timed;
+    VerticalDebouncer vertical;
+    timed.init();
+    timed.setEager(false);
+    vertical.init();
+
+    btn_bits_t raw;
+    btn_bits_t deb_timed;
+    btn_bits_t deb_vertical;
+    raw.fill(true); // Active-Low: alle losgelassen
+    deb_timed.fill(true);
+    deb_vertical.fill(true);
+
+    uint32_t run_left[BTN_COUNT];
+    uint8_t run_index[BTN_COUNT];
+    for (size_t i = 0; i < BTN_COUNT; ++i) {
+        run_left[i] = 1 + i % (SIM_RUN_LEN + 2); // Versatz zwischen den Tastern
+        run_index[i] = 0;
+    }
+
+    uint32_t edges = 0;
+    for (_cycle = 0; _cycle < SIM_DEBOUNCE_CHECK_CYCLES; ++_cycle) {
+        for (size_t i = 0; i < BTN_COUNT; ++i) {
+            if (--run_left[i] > 0) {
+                continue;
+            }
+            const uint8_t id = static_cast<uint8_t>(i + 1);
+            activeLow_setPressed(raw, id, !activeLow_pressed(raw, id));
+            if (i < SIM_RUN_PATTERN_COUNT) {
+                run_left[i] = SIM_RUN_PATTERNS[i][run_index[i]];
+                run_index[i] = static_cast<uint8_t>((run_index[i] + 1) % 6);
+            } else {
+                run_left[i] = random_range(1, SIM_RUN_LEN + 2);
+            }
+        }
+
+        const uint32_t now_ms =
+            static_cast<uint32_t>((uint64_t)_cycle * IO_PERIOD_US / 1000);
+        const bool changed_timed = timed.update(now_ms, raw, deb_timed);
+        const bool changed_vertical =
+            vertical.update(now_ms, raw, deb_vertical);
+
+        if (deb_timed != deb_vertical) {
+            for (size_t i = 0; i < BTN_COUNT; ++i) {
+                const uint8_t id = static_cast<uint8_t>(i + 1);
+                if (activeLow_pressed(deb_timed, id) !=
+                    activeLow_pressed(deb_vertical, id)) {
+                    fail("Entprell-Engines uneins (Taster / zeitbasiert)",
+                         id, activeLow_pressed(deb_timed, id));
+                    break;
+                }
+            }
+            deb_vertical = deb_timed; // Folgefehler vermeiden
+            vertical.init();
+        } else if (changed_timed != changed_vertical) {
+            fail("Entprell-Engines: Aenderung gemeldet", changed_timed,
+                 changed_vertical);
+        }
+        edges += changed_timed ? 1 : 0;
+    }
+
+    printf("Entprell-Abgleich: %u Zyklen, %u Taster, %u Zyklen mit "
+           "Uebernahme\n",
+           (unsigned)SIM_DEBOUNCE_CHECK_CYCLES, (unsigned)BTN_COUNT,
+           (unsigned)edges);
+}
+
+/**
+ * @brief Antwortzeile von command.cpp (send_line)
+ */
+static void sim_send_line(const char *line) {
+    if (!_expect_reply) {
+        fail("Antwort ohne Befehl", _replies, 0);
+    }
+    snprintf(_reply, sizeof(_reply), "%s", line);
+    _replies++;
+}
+
+/**
+ * @brief Uebrige Befehle: auf dem Host nur PING
+ */
+static bool sim_execute(const char *cmd) {
+    if (strcmp(cmd, "PING") != 0) {
+        return false;
+    }
+    sim_send_line("PONG");
+    return true;
+}
+
+/**
+ * @brief Commit wie im Serial-Task: mit Tag erst nach dem Latch bestaetigt
+ */
+static led_commit_e sim_commit(int32_t tag, bool, uint8_t, uint32_t,
+                               int16_t active_id) {
+    if (active_id != _sim.op.active_id) {
+        fail("CURLED-Auswahl falsch", active_id, _sim.op.active_id);
+    }
+    _sim.ack_sent++;
+    io_led_commit(_sim.ack_sent);
+    _report.led_cmds++;
+    return (tag >= 0) ? LED_COMMIT_DEFERRED : LED_COMMIT_NOW;
+}
+
+/**
+ * @brief Schickt eine Befehlszeile durch command.cpp und prueft die Antwort
+ * @param line Zeile wie vom Pi
+ * @param reply Erwartete Antwort, nullptr = keine
+ */
+static void send_command(const char *line, const char *reply) {
+    _reply[0] = '\0';
+    _replies = 0;
+    _expect_reply = true;
+    command_process(line);
+    _expect_reply = false;
+
+    const bool ok = (reply == nullptr)
+                        ? _replies == 0
+                        : _replies == 1 && strcmp(_reply, reply) == 0;
+    if (!ok) {
+        if (_report.errors < SIM_MAX_REPORTED) {
+            printf("  \"%s\" -> \"%s\", erwartet \"%s\"\n", line, _reply,
+                   reply != nullptr ? reply : "");
+        }
+        fail("Antwort falsch", _replies, reply != nullptr ? 1 : 0);
+    }
+}
+
+static void drain_events();
+
+/**
+ * @brief Prueft Tag-, Fehler- und Batch-Antworten von command.cpp
+ *
+ * Laeuft vor der Simulation: ABORT verwirft den gesammelten Frame, die
+ * beiden Commits veroeffentlichen den unveraenderten Startzustand
+ * (alle LEDs aus), den drain_events() beim Ack prueft.
+ */
+static void check_commands() {
+    _sim.op.active_id = -1;
+    send_command("PING", "PONG");
+    send_command("#12 PING", "PONG");
+    send_command("FOO", "ERROR UNKNOWN_CMD");
+    send_command("#x PING", "ERROR INVALID_TAG");
+    send_command("#70000 PING", "ERROR INVALID_TAG");
+    send_command("LEDON 000", "ERROR INVALID_ID");
+    send_command("#7 LEDSET 999", "#7 ERROR INVALID_ID");
+    send_command("LEDMASK XYZ", "ERROR INVALID_MASK");
+    send_command("COMMIT", "ERROR NO_BATCH");
+    send_command("ABORT", "ERROR NO_BATCH");
+
+    send_command("#3 BEGIN", "#3 OK");
+    send_command("BEGIN", "ERROR NESTED_BATCH");
+    send_command("LEDSET 001", nullptr);
+    send_command("LEDALL;BOGUS", nullptr);
+    send_command("PING", "PONG"); // Laeuft auch im offenen Block
+    send_command("ABORT", "OK");
+
+    send_command("BEGIN", "OK");
+    send_command("COMMIT", "BATCH 0 0");
+    io_sim_cycle(); // Latch, sonst zaehlt nur der zweite Ack
+    drain_events();
+    send_command("LEDON 000; ;LEDOFF 999", "BATCH 2 3");
+    printf("Befehls-Abgleich: %u Fehler\n", (unsigned)_report.errors);
+}
+
+/**
+ * @brief Erzeugt einen zufaelligen LED-Befehl als Zeile (ohne Senden)
+ *
+ * Erwarteter Frame: Befehl auf dem aktuellen Stand. LEDON/LEDOFF auf die
+ * Auswahl-LED und die absoluten Befehle ausser LEDSET loesen sie von der
+ * lokalen Auswahl. Sichtbar erst mit dem Commit; dazwischen darf der
+ * IO-Task lokal waehlen (Rebase-Basis veraltet).
+ */
+static void build_led_command() {
+    sim_led_op_t &op = _sim.op;
+    op.id = static_cast<uint8_t>(random_range(1, LED_COUNT));
+    op.cmd = static_cast<uint8_t>(random_range(0, 5));
+    op.active_id = -1;
+
+    led_bits_t &leds = _sim.op_leds;
+    leds = sim_panel_leds();
+    _sim.op_active = _sim.active;
+    _sim.op_sel_led = _sim.sel_led;
+    _sim.op_remote = true;
+
+    switch (op.cmd) {
+    case 0:
+        leds.fill(false);
+        led_set(leds, op.id, true);
+        _sim.op_active = op.id;
+        _sim.op_sel_led = op.id;
+        op.active_id = op.id;
+        snprintf(op.line, sizeof(op.line), "LEDSET %03u", op.id);
+        break;
+    case 1:
+    case 2:
+        led_set(leds, op.id, op.cmd == 1);
+        if (op.id == _sim.op_sel_led) {
+            _sim.op_sel_led = 0;
+        }
+        snprintf(op.line, sizeof(op.line), "%s %03u",
+                 op.cmd == 1 ? "LEDON" : "LEDOFF", op.id);
+        break;
+    case 3:
+        leds.fill(false);
+        _sim.op_active = 0;
+        _sim.op_sel_led = 0;
+        _sim.op_remote = false;
+        op.active_id = 0;
+        snprintf(op.line, sizeof(op.line), "LEDCLR");
+        break;
+    case 4:
+        leds.fill(true);
+        _sim.op_sel_led = 0;
+        snprintf(op.line, sizeof(op.line), "LEDALL");
+        break;
+    default: {
+        // Hex, letzte Ziffer = LED 1-4
+        const size_t digits = (LED_COUNT + 3) / 4;
+        int pos = snprintf(op.line, sizeof(op.line), "LEDMASK ");
+        leds.fill(false);
+        for (size_t k = digits; k-- > 0;) {
+            uint8_t nibble = 0;
+            for (uint8_t b = 0; b < 4; ++b) {
+                const size_t id = k * 4 + b + 1;
+                if (id <= LED_COUNT && (_rng() & 1u) != 0) {
+                    led_set(leds, static_cast<uint8_t>(id), true);
+                    nibble |= static_cast<uint8_t>(1u << b);
+                }
+            }
+            op.line[pos++] = "0123456789ABCDEF"[nibble];
+        }
+        op.line[pos] = '\0';
+        _sim.op_sel_led = 0;
+        break;
+    }
+    }
+}
+
+/**
+ * @brief Erwartung fuer den naechsten Commit festlegen
+ * @param stale Nach dem Sammeln lokal gewaehlt (ACTIVE)
+ *
+ * Veralteter Frame: Der IO-Task ersetzt beim Latch nur die Auswahl-LED
+ * durch die lokale Auswahl, alle anderen Bits gelten wie gesammelt.
+ */
+static void expect_led_command(bool stale) {
+    if (stale) {
+        led_set(_sim.op_leds, _sim.op_sel_led, false);
+        led_set(_sim.op_leds, _sim.btn, true);
+        _sim.op_active = _sim.btn;
+        _sim.op_sel_led = _sim.btn;
+        _sim.op_remote = false;
+    }
+
+    _sim.led_expect = _sim.op_leds;
+    _sim.active_expect = _sim.op_active;
+    _sim.sel_led = _sim.op_sel_led;
+    _sim.remote = _sim.op_remote;
+}
+
+/**
+ * @brief Sammelt einen zufaelligen LED-Befehl in einem BEGIN-Block
+ */
+static void stage_led_command() {
+    build_led_command();
+    send_command("BEGIN", "OK");
+    send_command(_sim.op.line, nullptr);
+}
+
+/**
+ * @brief Veroeffentlicht den BEGIN-Block (COMMIT)
+ * @param stale Nach dem Sammeln lokal gewaehlt (ACTIVE)
+ */
+static void commit_led_command(bool stale) {
+    expect_led_command(stale);
+    send_command("COMMIT", "BATCH 1 0");
+}
+
+/**
+ * @brief Schickt einen zufaelligen LED-Befehl als eine Zeile
+ *
+ * Jeder zweite mit Tag: Dann bestaetigt erst der Latch (IO_EVT_LED).
+ */
+static void send_led_command() {
+    build_led_command();
+    expect_led_command(false);
+    if ((_rng() & 1u) == 0) {
+        send_command(_sim.op.line, "OK");
+        return;
+    }
+    char line[SERIAL_RX_LINE_LEN + 8];
+    snprintf(line, sizeof(line), "#%u %s", (unsigned)(_rng() % 65536),
+             _sim.op.line);
+    send_command(line, nullptr);
+}
+
+/**
+ * @brief Stellt die Kontakte fuer den naechsten Zyklus ein
+ */
+static void drive_panel() {
+    if (_sim.phase_left > 0) {
+        _sim.phase_left--;
+    }
+
+    switch (_sim.phase) {
+    case SIM_IDLE:
+        // Pausen-Befehle nur, wenn der vorige bestaetigt ist
+        if (_sim.ack_seen == _sim.ack_sent && (_rng() % 8) == 0) {
+            send_led_command();
+        }
+        if (_sim.phase_left == 0 && _sim.ack_seen == _sim.ack_sent) {
+            _sim.btn = static_cast<uint8_t>(random_range(1, BTN_COUNT));
+            _sim.active_events = 0;
+            _sim.local_latched = false;
+            _sim.contact_us = 0;
+            // Befehl sammeln, Commit erst nach der lokalen Auswahl: Der
+            // Frame baut dann auf einer veralteten Basis auf
+            _sim.op_in_press = (_rng() % 4) == 0;
+            if (_sim.op_in_press) {
+                stage_led_command();
+                _sim.op_staged = true;
+            }
+            _sim.phase = SIM_PRESS_BOUNCE;
+            _sim.phase_left = random_range(0, SIM_BOUNCE_MAX_CYCLES);
+            _report.presses++;
+        }
+        break;
+
+    case SIM_PRESS_BOUNCE: {
+        const bool contact = (_rng() & 1u) != 0 || _sim.phase_left == 0;
+        sim_panel_set_pressed(_sim.btn, contact);
+        if (contact && _sim.contact_us == 0) {
+            _sim.contact_us = sim_clock_us() + IO_PERIOD_US; // Abtastung
+        }
+        if (_sim.phase_left == 0) {
+            _sim.stable_us = sim_clock_us() + IO_PERIOD_US;
+            _sim.phase = SIM_HOLD;
+            _sim.phase_left = SIM_DEBOUNCE_CYCLES + random_range(3, 40);
+        }
+        break;
+    }
+
+    case SIM_HOLD:
+        if (_sim.phase_left == 0) {
+            // Taster war schon aktiv: kein ACTIVE, Commit ohne Rebase
+            if (_sim.op_staged) {
+                _sim.op_staged = false;
+                commit_led_command(false);
+            }
+            // Nach DEBOUNCE_MS muss die Auswahl stehen (ein Befehl nach
+            // dem ACTIVE wird stattdessen beim Ack geprueft)
+            if (!_sim.op_in_press && _sim.active != _sim.btn) {
+                fail("Auswahl falsch", _sim.active, _sim.btn);
+            }
+            if (_sim.local_latched && !_sim.op_in_press) {
+                led_bits_t expect;
+                led_set(expect, _sim.btn, true);
+                if (sim_panel_leds() != expect) {
+                    fail("LEDs nicht One-Hot", led_word(sim_panel_leds()),
+                         led_word(expect));
+                }
+            }
+            _sim.phase = SIM_RELEASE_BOUNCE;
+            _sim.phase_left = random_range(0, SIM_BOUNCE_MAX_CYCLES);
+        }
+        break;
+
+    case SIM_RELEASE_BOUNCE:
+        sim_panel_set_pressed(_sim.btn, (_rng() & 1u) != 0);
+        if (_sim.phase_left == 0) {
+            sim_panel_set_pressed(_sim.btn, false);
+            _sim.phase = SIM_IDLE;
+            _sim.phase_left = SIM_DEBOUNCE_CYCLES + random_range(2, 20);
+        }
+        break;
+    }
+}
+
+/**
+ * @brief Liest alle Events des Zyklus (Rolle des Serial-Tasks)
+ */
+static void drain_events() {
+    io_event_t event;
+    while (_log_channel.events.pop(event)) {
+        _report.events++;
+        if (event.seq != _sim.next_seq) {
+            fail("Luecke in Laufnummer", event.seq, _sim.next_seq);
+        }
+        _sim.next_seq = static_cast<uint16_t>(event.seq + 1);
+
+        switch (event.type) {
+        case IO_EVT_PRESS:
+        case IO_EVT_RELEASE:
+            if (event.id != _sim.btn) {
+                fail("Flanke an falschem Taster", event.id, _sim.btn);
+            }
+            _sim.held = (event.type == IO_EVT_PRESS);
+            break;
+
+        case IO_EVT_ACTIVE: {
+            _sim.active = event.id;
+            if (event.id == 0) {
+                // LATCH_SELECTION = false: Loslassen, LEDs nur lokal
+                if (!_sim.remote) {
+                    _sim.sel_led = 0;
+                }
+                break;
+            }
+            _sim.sel_led = event.id;
+            _sim.remote = false;
+            if (++_sim.active_events > 1) {
+                fail("Doppeltes ACTIVE (Prellen)", event.id, _sim.btn);
+            }
+            // TRACE: edge_us = erster Kontakt, nicht letzte Prell-Flanke
+            if (event.edge_us != static_cast<uint32_t>(_sim.contact_us)) {
+                fail("Roh-Flanke falsch", event.edge_us,
+                     static_cast<uint32_t>(_sim.contact_us));
+            }
+            _sim.local_latched = true;
+            if (_sim.op_staged) {
+                _sim.op_staged = false;
+                commit_led_command(true);
+            }
+
+            const uint32_t latency =
+                event.us - static_cast<uint32_t>(DEBOUNCE_EAGER
+                                                     ? _sim.contact_us
+                                                     : _sim.stable_us);
+            if (latency > SIM_LATENCY_MAX_US) {
+                fail("Latenz ueber Budget", latency, SIM_LATENCY_MAX_US);
+            }
+            _report.latency_sum += latency;
+            _report.latency_n++;
+            if (latency > _report.latency_max) {
+                _report.latency_max = latency;
+            }
+            break;
+        }
+
+        case IO_EVT_LED:
+            if (event.id != static_cast<uint8_t>(_sim.ack_seen + 1)) {
+                fail("Ack ausser Reihe", event.id, _sim.ack_seen + 1);
+            }
+            _sim.ack_seen = event.id;
+            if (event.id != _sim.ack_sent) {
+                break;
+            }
+            // LATCH_SELECTION = false: Ohne gedrueckten Taster setzt die
+            // Auswahl im selben Zyklus auf 0 (ACTIVE 0, LEDs bleiben remote)
+            if (!LATCH_SELECTION && !_sim.held) {
+                _sim.active_expect = 0;
+            }
+            _sim.active = _sim.active_expect;
+            if (sim_panel_leds() != _sim.led_expect) {
+                fail("LED-Frame nach Ack falsch", led_word(sim_panel_leds()),
+                     led_word(_sim.led_expect));
+            }
+            // Nur LEDSET/LEDCLR aendern die Auswahl
+            if (io_sim_active_id() != _sim.active_expect) {
+                fail("Auswahl nach Ack falsch", io_sim_active_id(),
+                     _sim.active_expect);
+            }
+            break;
+
+        default:
+            fail("Unbekannter Event-Typ", event.type, 0);
+            break;
+        }
+    }
+}
+
+// =============================================================================
+// ENTRY POINT
+// =============================================================================
+
+int main(int argc, char **argv) {
+    const uint32_t cycles = (argc > 1) ? strtoul(argv[1], nullptr, 10)
+                                       : SIM_DEFAULT_CYCLES;
+    const uint32_t seed = (argc > 2) ? strtoul(argv[2], nullptr, 10) : 1;
+    _rng.seed(seed);
+
+    check_debounce_engines();
+
+    io_sim_begin(&_log_channel);
+    io_set_edge_events(true);
+
+    const command_hooks_t hooks = {sim_send_line, sim_execute, sim_commit};
+    command_init(hooks);
+    _cycle = 0;
+    check_commands();
+
+    _sim.phase = SIM_IDLE;
+    _sim.phase_left = SIM_DEBOUNCE_CYCLES;
+
+    const auto t_start = std::chrono::steady_clock::now();
+    for (_cycle = 0; _cycle < cycles; ++_cycle) {
+        drive_panel();
+        io_sim_cycle();
+        drain_events();
+        command_check_timeout(); // BEGIN-Block darf nie verfallen
+    }
+    const auto t_end = std::chrono::steady_clock::now();
+
+    const double host_s =
+        std::chrono::duration<double>(t_end - t_start).count();
+    sim_panel_stats_t panel;
+    sim_panel_get_stats(&panel);
+
+    printf("IO-Simulation: %u Zyklen (%.0f s simuliert), Seed %u\n",
+           (unsigned)cycles, sim_clock_us() / 1e6, (unsigned)seed);
+    printf("Tastendruecke %u, LED-Befehle %u, Events %u (Ring-Verluste %u)\n",
+           (unsigned)_report.presses, (unsigned)_report.led_cmds,
+           (unsigned)_report.events,
+           (unsigned)_log_channel.events.overflows());
+    printf("Panel: %u Loads, %u Latches, %u SPI-Bytes, %u Notifies\n",
+           (unsigned)panel.loads, (unsigned)panel.latches,
+           (unsigned)panel.spi_bytes, (unsigned)panel.notifies);
+    if (_report.latency_n > 0) {
+        printf("Latenz Kontakt %s -> ACTIVE: mittel %u us, max %u us\n",
+               DEBOUNCE_EAGER ? "erster" : "stabil",
+               (unsigned)(_report.latency_sum / _report.latency_n),
+               (unsigned)_report.latency_max);
+    }
+    printf("Host: %.2f s, %.2f Mio Zyklen/s\n", host_s,
+           (host_s > 0) ? cycles / host_s / 1e6 : 0.0);
+
+    if (_log_channel.events.overflows() > 0) {
+        fail("Event-Ring uebergelaufen", _log_channel.events.overflows(), 0);
+    }
+    printf("Fehler: %u\n", (unsigned)_report.errors);
+    return (_report.errors == 0) ? 0 : 1;
+}
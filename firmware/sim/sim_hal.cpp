@@ -0,0 +1,237 @@
+/**
+ * @file sim_hal.cpp
+ * @brief SpiBus, Cd4021, Hc595 und ScanTimer auf dem simulierten Panel
+ *
+ * Gleiche Klassen-Header wie auf dem Target, nur die Implementierung
+ * tauscht GPIO/SPI gegen das Modell. DuplexScan laeuft unveraendert darauf.
+ * Dazu die Funktionen des Serial-Tasks, die der IO-Task aufruft.
+ *
+ * Bit-Layout auf dem Bus:
+ * - Taster: rx[0] Bit7 = Taster 1 (wie SCAN-Transfer, ohne First-Bit-Versatz)
+ * - LEDs: letztes gesendetes Byte landet in IC0 (LED 1-8)
+ */
+
+// =============================================================================
+// INCLUDES
+// =============================================================================
+
+#include "sim_hal.h"
+
+#include "config.h"
+#include "drivers/cd4021.h"
+#include "drivers/hc595.h"
+#include "hal/scan_timer.h"
+#include "hal/spi_bus.h"
+
+// =============================================================================
+// MODUL-LOKALE VARIABLEN
+// =============================================================================
+
+// Kontakte (Active-Low wie btn_bits_t) und CD4021B-Register nach Parallel-Load
+static btn_bits_t _contacts;
+static btn_bits_t _btn_register;
+static bool _contacts_ready = false;
+
+// 74HC595: Schieberegister der Kette und gelatchte Ausgaenge
+static uint8_t _led_shift[LED_BYTES] = {0};
+static led_bits_t _led_out;
+
+// Laufender Transfer (startTransfer bis finishTransfer)
+static uint8_t _pending_rx[SPI_MAX_TRANSFER] = {0};
+
+// ScanTimer: naechster Tick
+static uint64_t _timer_next_us = 0;
+static uint32_t _timer_period_us = 0;
+
+static sim_panel_stats_t _stats = {};
+
+// =============================================================================
+// PRIVATE HILFSFUNKTIONEN
+// =============================================================================
+
+/**
+ * @brief Kontakte beim ersten Zugriff auf "losgelassen" (BitSet startet bei 0)
+ */
+static btn_bits_t &contacts() {
+    if (!_contacts_ready) {
+        _contacts.fill(true);
+        _contacts_ready = true;
+    }
+    return _contacts;
+}
+
+/**
+ * @brief Ein Bus-Transfer auf der Hardware-Kette
+ * @param dev Geraete-Profil (bestimmt, welche Kette mithoert)
+ * @param tx Sendedaten (nullptr = 0x00)
+ * @param rx Empfangsdaten (nullptr = verwerfen)
+ * @param len Anzahl Bytes
+ */
+static void shift_chain(spi_device_e dev, const uint8_t *tx, uint8_t *rx,
+                        size_t len) {
+    _stats.spi_bytes += len;
+
+    // 74HC595: Nur die letzten LED_BYTES Bytes bleiben in der Kette
+    if (dev == SPI_DEV_LED || dev == SPI_DEV_SCAN) {
+        for (size_t k = 0; k < len; ++k) {
+            memmove(_led_shift, _led_shift + 1, LED_BYTES - 1);
+            _led_shift[LED_BYTES - 1] = (tx != nullptr) ? tx[k] : 0x00;
+        }
+    }
+
+    // CD4021B: Register von vorne, danach schiebt der Serial-In (Pull-up) 1en
+    if (rx != nullptr) {
+        const uint8_t *reg = _btn_register.data();
+        for (size_t k = 0; k < len; ++k) {
+            rx[k] = (k < BTN_BYTES) ? reg[k] : 0xFF;
+        }
+    }
+}
+
+// =============================================================================
+// OEFFENTLICHE FUNKTIONEN: Panel
+// =============================================================================
+
+void sim_panel_set_pressed(uint8_t id, bool pressed) {
+    activeLow_setPressed(contacts(), id, pressed);
+}
+
+const led_bits_t &sim_panel_leds() { return _led_out; }
+
+void sim_panel_get_stats(sim_panel_stats_t *out) { *out = _stats; }
+
+// =============================================================================
+// SpiBus
+// =============================================================================
+
+bool SpiBus::begin(int, int, int) {
+    _mtx = xSemaphoreCreateMutex();
+    _ready = true;
+    return true;
+}
+
+void SpiBus::lock() { xSemaphoreTake(_mtx, portMAX_DELAY); }
+
+void SpiBus::unlock() { xSemaphoreGive(_mtx); }
+
+bool SpiBus::transfer(spi_device_e dev, const uint8_t *tx, uint8_t *rx,
+                      size_t len) {
+    if (len == 0 || len > SPI_MAX_TRANSFER) {
+        return false;
+    }
+
+    lock();
+    shift_chain(dev, tx, rx, len);
+    unlock();
+    return true;
+}
+
+bool SpiBus::startTransfer(spi_device_e dev, const uint8_t *tx, size_t len) {
+    if (len == 0 || len > SPI_MAX_TRANSFER) {
+        return false;
+    }
+
+    lock();
+    shift_chain(dev, tx, _pending_rx, len);
+    _pending = true;
+    return true;
+}
+
+bool SpiBus::finishTransfer(uint8_t *rx, size_t len) {
+    if (!_pending) {
+        return false;
+    }
+
+    if (rx != nullptr) {
+        memcpy(rx, _pending_rx, len);
+    }
+    _pending = false;
+    unlock();
+    return true;
+}
+
+// =============================================================================
+// Cd4021
+// =============================================================================
+
+void Cd4021::init() { contacts(); }
+
+void Cd4021::parallelLoad() {
+    _btn_register = contacts();
+    _stats.loads++;
+}
+
+void Cd4021::readRaw(SpiBus &bus, btn_bits_t &out) {
+    parallelLoad();
+
+    uint8_t rx[BTN_BYTES] = {0};
+    if (!bus.transfer(SPI_DEV_BTN, nullptr, rx, BTN_BYTES)) {
+        return; // Bus-Fehler: letzten Zustand behalten
+    }
+
+    memcpy(out.data(), rx, BTN_BYTES);
+    out.mask_unused();
+}
+
+// =============================================================================
+// Hc595
+// =============================================================================
+
+void Hc595::init() {}
+
+void Hc595::setBrightness(uint8_t) {}
+
+void Hc595::write(SpiBus &bus, led_bits_t &state) {
+    state.mask_unused();
+    const uint8_t *bytes = state.data();
+
+    // Daisy-Chain: Letztes Byte zuerst senden (wie hc595.cpp)
+    uint8_t tx[LED_BYTES];
+    for (size_t k = 0; k < LED_BYTES; ++k) {
+        tx[k] = bytes[LED_BYTES - 1 - k];
+    }
+
+    if (!bus.transfer(SPI_DEV_LED, tx, nullptr, LED_BYTES)) {
+        return;
+    }
+
+    latch();
+}
+
+void Hc595::latch() {
+    // Zuletzt gesendetes Byte steht in IC0 (LED 1-8)
+    uint8_t *out = _led_out.data();
+    for (size_t k = 0; k < LED_BYTES; ++k) {
+        out[k] = _led_shift[LED_BYTES - 1 - k];
+    }
+    _led_out.mask_unused();
+    _stats.latches++;
+}
+
+// =============================================================================
+// ScanTimer
+// =============================================================================
+
+bool ScanTimer::begin(uint32_t period_us) {
+    _timer_period_us = period_us;
+    _timer_next_us = sim_clock_us() + period_us;
+    return true;
+}
+
+uint32_t ScanTimer::wait() {
+    // Verpasste Ticks wie beim Hardware-Timer mitzaehlen
+    uint32_t ticks = 1;
+    while (sim_clock_us() >= _timer_next_us + _timer_period_us) {
+        _timer_next_us += _timer_period_us;
+        ticks++;
+    }
+    sim_clock_advance_to(_timer_next_us);
+    _timer_next_us += _timer_period_us;
+    return ticks;
+}
+
+// =============================================================================
+// Serial-Task-Seite
+// =============================================================================
+
+void notify_serial_task() { _stats.notifies++; }
@@ -0,0 +1,62 @@
+/**
+ * @file sim_hal.h
+ * @brief Simuliertes Panel fuer env:native (Taster-Kontakte, LED-Ausgaenge)
+ *
+ * Ersetzt auf dem Host die Hardware hinter SpiBus, Cd4021, Hc595 und
+ * ScanTimer sowie notify_serial_task() (alles in sim_hal.cpp). Die Header
+ * in src/ bleiben unveraendert. LED-Befehle laufen als Zeilen durch
+ * src/app/command.cpp.
+ *
+ * Modell:
+ * - Kontakte: was der Taster gerade tut (inkl. Prellen durch den Aufrufer)
+ * - CD4021B: Parallel-Load friert die Kontakte ein, SPI liest das Register
+ * - 74HC595: SPI schiebt in die Kette, Latch uebernimmt auf die Ausgaenge
+ */
+#ifndef SIM_HAL_H
+#define SIM_HAL_H
+
+// =============================================================================
+// INCLUDES
+// =============================================================================
+
+#include "app/serial_task.h"
+#include "bitops.h"
+#include <stdint.h>
+
+// =============================================================================
+// TYPES
+// =============================================================================
+
+/**
+ * @brief Zaehler des simulierten Panels
+ */
+typedef struct sim_panel_stats {
+    uint32_t loads;     /**< Parallel-Loads (CD4021B) */
+    uint32_t latches;   /**< Latch-Impulse (74HC595) */
+    uint32_t spi_bytes; /**< Uebertragene SPI-Bytes */
+    uint32_t notifies;  /**< notify_serial_task() Aufrufe */
+} sim_panel_stats_t;
+
+// =============================================================================
+// OEFFENTLICHE FUNKTIONEN: Panel
+// =============================================================================
+
+/**
+ * @brief Setzt den Kontakt eines Tasters
+ * @param id Taster-ID (1-BTN_COUNT)
+ * @param pressed true = Kontakt geschlossen
+ */
+void sim_panel_set_pressed(uint8_t id, bool pressed);
+
+/**
+ * @brief Liefert die gelatchten LED-Ausgaenge der 74HC595-Kette
+ */
+const led_bits_t &sim_panel_leds();
+
+/**
+ * @brief Liest die Zaehler des Panels
+ * @param out Ziel
+ */
+void sim_panel_get_stats(sim_panel_stats_t *out);
+
+#endif // SIM_HAL_H
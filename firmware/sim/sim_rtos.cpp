@@ -0,0 +1,178 @@
+/**
+ * @file sim_rtos.cpp
+ * @brief Simulierte Uhr, FreeRTOS- und Arduino-Globals fuer env:native
+ */
+
+// =============================================================================
+// INCLUDES
+// =============================================================================
+
+#include <Arduino.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+
+// =============================================================================
+// TYPES
+// =============================================================================
+
+/**
+ * @brief Queue: Ringpuffer mit fester Tiefe (Elemente werden kopiert)
+ */
+struct sim_queue {
+    uint8_t *buf;          /**< length * item_size Bytes */
+    UBaseType_t length;    /**< Tiefe */
+    UBaseType_t item_size; /**< Bytes pro Element (0 = Semaphore) */
+    UBaseType_t head;      /**< Naechstes Element zum Lesen */
+    UBaseType_t count;     /**< Belegte Plaetze */
+};
+
+// =============================================================================
+// MODUL-LOKALE VARIABLEN
+// =============================================================================
+
+static uint64_t _now_us = 0;
+static uint32_t _notify_count = 0;
+
+// =============================================================================
+// GLOBALS (wie im Arduino-Core)
+// =============================================================================
+
+EspClass ESP;
+
+// =============================================================================
+// OEFFENTLICHE FUNKTIONEN: Uhr
+// =============================================================================
+
+uint64_t sim_clock_us() { return _now_us; }
+
+void sim_clock_advance_us(uint64_t us) { _now_us += us; }
+
+void sim_clock_advance_to(uint64_t us) {
+    if (us > _now_us) {
+        _now_us = us;
+    }
+}
+
+// =============================================================================
+// OEFFENTLICHE FUNKTIONEN: Tasks
+// =============================================================================
+
+TickType_t xTaskGetTickCount() {
+    return static_cast<TickType_t>(_now_us / 1000);
+}
+
+void vTaskDelayUntil(TickType_t *prev, TickType_t period) {
+    // Wie FreeRTOS: Soll-Zeitpunkt weiterzaehlen, ist er schon vorbei
+    // (Zyklus zu lang), geht es ohne Warten weiter
+    *prev += period;
+    sim_clock_advance_to(static_cast<uint64_t>(*prev) * 1000);
+}
+
+void vTaskDelay(TickType_t ticks) {
+    if (ticks != portMAX_DELAY) {
+        sim_clock_advance_us(static_cast<uint64_t>(ticks) * 1000);
+    }
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t, const char *, uint32_t,
+                                   void *, UBaseType_t, TaskHandle_t *,
+                                   BaseType_t) {
+    return pdFAIL;
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle() { return nullptr; }
+
+BaseType_t xTaskNotifyGive(TaskHandle_t) {
+    _notify_count++;
+    return pdPASS;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clear, TickType_t) {
+    const uint32_t count = _notify_count;
+    _notify_count = (clear != pdFALSE) ? 0 : (count > 0 ? count - 1 : 0);
+    return count;
+}
+
+// =============================================================================
+// OEFFENTLICHE FUNKTIONEN: Queues
+// =============================================================================
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t item_size) {
+    if (length == 0) {
+        return nullptr;
+    }
+
+    sim_queue *queue = static_cast<sim_queue *>(calloc(1, sizeof(sim_queue)));
+    if (queue == nullptr) {
+        return nullptr;
+    }
+    if (item_size > 0) {
+        queue->buf = static_cast<uint8_t *>(malloc(length * item_size));
+        if (queue->buf == nullptr) {
+            free(queue);
+            return nullptr;
+        }
+    }
+    queue->length = length;
+    queue->item_size = item_size;
+    return queue;
+}
+
+void vQueueDelete(QueueHandle_t queue) {
+    if (queue != nullptr) {
+        free(queue->buf);
+        free(queue);
+    }
+}
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void *item, TickType_t) {
+    if (queue == nullptr || queue->count == queue->length) {
+        return pdFALSE; // Voll: ohne Scheduler wird niemand Platz machen
+    }
+
+    const UBaseType_t tail = (queue->head + queue->count) % queue->length;
+    if (queue->item_size > 0 && item != nullptr) {
+        memcpy(queue->buf + tail * queue->item_size, item, queue->item_size);
+    }
+    queue->count++;
+    return pdTRUE;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void *out, TickType_t) {
+    if (queue == nullptr || queue->count == 0) {
+        return pdFALSE;
+    }
+
+    if (queue->item_size > 0 && out != nullptr) {
+        memcpy(out, queue->buf + queue->head * queue->item_size,
+               queue->item_size);
+    }
+    queue->head = (queue->head + 1) % queue->length;
+    queue->count--;
+    return pdTRUE;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue) {
+    return (queue != nullptr) ? queue->count : 0;
+}
+
+// =============================================================================
+// OEFFENTLICHE FUNKTIONEN: Mutex
+// =============================================================================
+
+SemaphoreHandle_t xSemaphoreCreateMutex() {
+    SemaphoreHandle_t mutex = xQueueCreate(1, 0);
+    xSemaphoreGive(mutex); // Mutex startet frei
+    return mutex;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t mutex, TickType_t wait) {
+    return xQueueReceive(mutex, nullptr, wait);
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t mutex) {
+    return xQueueSend(mutex, nullptr, 0);
+}
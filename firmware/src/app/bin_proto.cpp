@@ -0,0 +1,57 @@
+/**
+ * @file bin_proto.cpp
+ * @brief Binaeres Serial-Protokoll Implementation
+ */
+
+// =============================================================================
+// INCLUDES
+// =============================================================================
+
+#include "app/bin_proto.h"
+#include <string.h>
+
+// =============================================================================
+// OEFFENTLICHE FUNKTIONEN
+// =============================================================================
+
+size_t bin_encode(uint8_t op, uint8_t seq, const uint8_t *payload, size_t len,
+                  uint8_t *out) {
+    uint8_t raw[BIN_RAW_MAX];
+
+    if (len > BIN_PAYLOAD_MAX) {
+        len = BIN_PAYLOAD_MAX;
+    }
+
+    raw[0] = op;
+    raw[1] = seq;
+    if (len > 0) {
+        memcpy(raw + 2, payload, len);
+    }
+
+    const uint16_t crc = crc16_ccitt(raw, len + 2);
+    raw[len + 2] = (uint8_t)(crc & 0xFF);
+    raw[len + 3] = (uint8_t)(crc >> 8);
+
+    const size_t n = cobs_encode(raw, len + 4, out);
+    out[n] = 0x00; // Frame-Trenner
+    return n + 1;
+}
+
+bool bin_decode(const uint8_t *in, size_t n, uint8_t *buf, bin_frame_t *out) {
+    const size_t len = cobs_decode(in, n, buf);
+    if (len < 4 || len > BIN_RAW_MAX) {
+        return false; // Kodierfehler, kuerzer als op/seq/crc oder zu lang
+    }
+
+    const uint16_t crc = crc16_ccitt(buf, len - 2);
+    if (buf[len - 2] != (uint8_t)(crc & 0xFF) ||
+        buf[len - 1] != (uint8_t)(crc >> 8)) {
+        return false;
+    }
+
+    out->op = buf[0];
+    out->seq = buf[1];
+    out->payload = buf + 2;
+    out->len = len - 4;
+    return true;
+}
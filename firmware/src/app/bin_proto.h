@@ -0,0 +1,119 @@
+/**
+ * @file bin_proto.h
+ * @brief Binaeres Serial-Protokoll (COBS + CRC16), per "PROTO BIN"
+ *
+ * Warum neben ASCII?
+ * - ASCII braucht vsnprintf() im ESP32 und Fragment-Heuristik am Pi
+ * - Ein zerrissenes "PRESS 001" kann am Pi als Zahl (Phantom-PRESS) enden
+ *
+ * Frame (vor COBS):
+ *   [op][seq][payload 0..BIN_PAYLOAD_MAX][crc16 LE]
+ * Auf der Leitung: COBS(frame) + 0x00
+ *
+ * - op:  Opcode (bin_op_e), Bit 7 = Richtung Pi → ESP32
+ * - seq: ESP32 → Pi: eigener Zaehler (Luecke = verlorener Frame)
+ *        Pi → ESP32: vom Pi vergeben, kommt in ACK/PONG zurueck
+ * - Zeitstempel: uint32 LE in us (micros() des ESP32)
+ *
+ * Ein Frame passt immer in ein USB-Paket (BIN_FRAME_MAX <= 64).
+ */
+#ifndef BIN_PROTO_H
+#define BIN_PROTO_H
+
+// =============================================================================
+// INCLUDES
+// =============================================================================
+
+#include "cobs.h"
+#include <stddef.h>
+#include <stdint.h>
+
+// =============================================================================
+// KONSTANTEN
+// =============================================================================
+
+// Nutzdaten pro Frame: 64 Byte Paket - COBS(1) - 0x00(1) - op/seq(2) - CRC(2)
+constexpr size_t BIN_PAYLOAD_MAX = 58;
+
+// Rohframe und kodierter Frame inkl. 0x00-Trenner
+constexpr size_t BIN_RAW_MAX = BIN_PAYLOAD_MAX + 4;
+constexpr size_t BIN_FRAME_MAX = cobs_max_encoded(BIN_RAW_MAX) + 1;
+static_assert(BIN_FRAME_MAX <= 64, "Frame muss in ein USB-Paket passen");
+
+// =============================================================================
+// TYPES
+// =============================================================================
+
+/**
+ * @brief Opcodes (Bit 7 gesetzt = Befehl vom Pi)
+ */
+typedef enum bin_op {
+    // ESP32 → Pi
+    BIN_OP_PRESS = 0x01,   /**< [id][us32] Auswahl-Wechsel */
+    BIN_OP_RELEASE = 0x02, /**< [id][us32] Auswahl aufgehoben */
+    BIN_OP_DOWN = 0x03,    /**< [id][us32] Taster-Flanke (EDGES ON) */
+    BIN_OP_UP = 0x04,      /**< [id][us32] Taster-Flanke (EDGES ON) */
+    BIN_OP_ACK = 0x10,     /**< [status] Antwort, seq = Befehls-seq */
+    BIN_OP_PONG = 0x11,    /**< [] Antwort auf PING, seq = Befehls-seq */
+    BIN_OP_TEXT = 0x20,    /**< [ascii] Protokollzeile (STATUS, OK, ...) */
+    BIN_OP_TEXT_MORE = 0x21, /**< [ascii] Zeilenanfang, Rest folgt */
+
+    // Pi → ESP32
+    BIN_OP_LEDSET = 0x81,   /**< [id] */
+    BIN_OP_LEDON = 0x82,    /**< [id] */
+    BIN_OP_LEDOFF = 0x83,   /**< [id] */
+    BIN_OP_LEDCLR = 0x84,   /**< [] */
+    BIN_OP_LEDALL = 0x85,   /**< [] */
+    BIN_OP_PING = 0x86,     /**< [] */
+    BIN_OP_LEDMASK = 0x87,  /**< [led_bits_t-Bytes] ganzer LED-Frame */
+    BIN_OP_CMD_TEXT = 0xA0  /**< [ascii] beliebiger ASCII-Befehl */
+} bin_op_e;
+
+/**
+ * @brief Status im ACK-Frame
+ */
+typedef enum bin_status {
+    BIN_STATUS_OK = 0,
+    BIN_STATUS_INVALID_ID = 1,
+    BIN_STATUS_UNKNOWN_OP = 2,
+    BIN_STATUS_BAD_LENGTH = 3,
+    BIN_STATUS_BUSY = 4 /**< LED-Befehl verworfen (Bestaetigungen voll) */
+} bin_status_e;
+
+/**
+ * @brief Dekodierter Frame (zeigt in den Dekodierpuffer)
+ */
+typedef struct bin_frame {
+    uint8_t op;             /**< Opcode */
+    uint8_t seq;            /**< Laufnummer */
+    const uint8_t *payload; /**< Nutzdaten */
+    size_t len;             /**< Laenge der Nutzdaten */
+} bin_frame_t;
+
+// =============================================================================
+// OEFFENTLICHE FUNKTIONEN
+// =============================================================================
+
+/**
+ * @brief Baut einen Frame inkl. CRC, COBS und 0x00-Trenner
+ * @param op Opcode
+ * @param seq Laufnummer
+ * @param payload Nutzdaten (darf nullptr sein wenn len == 0)
+ * @param len Laenge (wird auf BIN_PAYLOAD_MAX begrenzt)
+ * @param out Ziel (mind. BIN_FRAME_MAX Bytes)
+ * @return Laenge auf der Leitung
+ */
+size_t bin_encode(uint8_t op, uint8_t seq, const uint8_t *payload, size_t len,
+                  uint8_t *out);
+
+/**
+ * @brief Dekodiert einen Frame (ohne 0x00) und prueft die CRC
+ * @param in Kodierte Bytes
+ * @param n Anzahl
+ * @param buf Dekodierpuffer (mind. n Bytes, bleibt gueltig fuer out)
+ * @param out Frame
+ * @return false bei COBS-, Laengen- oder CRC-Fehler
+ */
+bool bin_decode(const uint8_t *in, size_t n, uint8_t *buf, bin_frame_t *out);
+
+#endif // BIN_PROTO_H
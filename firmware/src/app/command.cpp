@@ -0,0 +1,470 @@
+/**
+ * @file command.cpp
+ * @brief Befehlszeilen vom Pi: Tag, Batch und LED-Befehle
+ *
+ * Aus serial_task.cpp herausgeloest, damit die Host-Simulation Parser und
+ * Batch-Logik mit echten Zeilen treiben kann. Alles, was USB-CDC,
+ * FreeRTOS-Queues oder die Bestaetigungs-FIFO braucht, bleibt hinter
+ * command_hooks_t im Serial-Task.
+ */
+
+// =============================================================================
+// INCLUDES
+// =============================================================================
+
+#include "app/command.h"
+#include "app/io_task.h"
+
+#include "bitops.h"
+#include "config.h"
+#include "types.h"
+#include <Arduino.h>
+#include <stdarg.h>
+
+// =============================================================================
+// TYPES
+// =============================================================================
+
+/**
+ * @brief Ergebnis beim Sammeln eines LED-Befehls
+ */
+typedef enum led_item {
+    LED_ITEM_OK,     /**< Im Back-Buffer, wird mit dem Commit sichtbar */
+    LED_ITEM_ERROR,  /**< LED-Befehl mit ungueltigem Parameter */
+    LED_ITEM_UNKNOWN /**< Kein LED-Befehl */
+} led_item_e;
+
+// =============================================================================
+// MODUL-LOKALE VARIABLEN
+// =============================================================================
+
+static command_hooks_t _hooks = {};
+static led_control_callback_t _led_callback = nullptr;
+static led_mask_callback_t _led_mask_callback = nullptr;
+
+// LEDSET/LEDCLR vor dem Commit (fuer CURLED), -1 = keiner
+static int16_t _staged_active_id = -1;
+
+// Befehls-Tag (#n) der gerade verarbeiteten Zeile, -1 = ohne
+static int32_t _cmd_tag = -1;
+
+// Batch: "LEDCLR;LEDON 003" bzw. BEGIN ... COMMIT, ein Frame pro Batch
+static bool _batch_open = false;   // BEGIN gesehen, COMMIT fehlt noch
+static int32_t _batch_tag = -1;    // Tag von BEGIN (fuer BATCH_TIMEOUT)
+static uint32_t _batch_ms = 0;     // Letzte Zeile im offenen Block
+static uint8_t _batch_items = 0;   // Gesammelte Eintraege
+static uint32_t _batch_errors = 0; // Bit i = Eintrag i+1 fehlerhaft
+static_assert(SERIAL_BATCH_MAX <= 32, "Fehler-Bitmap ist 32 Bit breit");
+
+// =============================================================================
+// PRIVATE HILFSFUNKTIONEN
+// =============================================================================
+
+/**
+ * @brief Formatiert und sendet eine Antwortzeile
+ */
+static void send_linef(const char *fmt, ...) {
+    char line[64];
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(line, sizeof(line), fmt, args);
+    va_end(args);
+    _hooks.send_line(line);
+}
+
+/**
+ * @brief Parst eine ID (001-100) aus einem String
+ * @return ID (1-LED_COUNT) oder -1 bei Fehler
+ */
+static int parse_id(const char *str) {
+    while (*str == ' ') {
+        str++; // Leerzeichen ueberspringen
+    }
+    int id = atoi(str);
+    if (id >= 1 && id <= LED_COUNT) {
+        return id;
+    }
+    return -1;
+}
+
+/**
+ * @brief Parst eine LED-Maske als Hex-Zahl (Bit 0 = LED 1)
+ * @param str Hex-Ziffern, z.B. "3FF" = LED 1-10 an
+ * @param mask Ziel
+ * @return false bei ungueltiger Ziffer oder Bit ueber LED_COUNT
+ */
+static bool parse_led_mask(const char *str, led_bits_t &mask) {
+    while (*str == ' ') {
+        str++;
+    }
+    while (str[0] == '0' && str[1] != '\0') {
+        str++; // Fuehrende Nullen
+    }
+
+    const size_t len = strlen(str);
+    if (len == 0 || len > (LED_COUNT + 3) / 4) {
+        return false;
+    }
+
+    mask.fill(false);
+    for (size_t k = 0; k < len; k++) {
+        const char c = str[len - 1 - k]; // Letzte Ziffer = LED 1-4
+        uint8_t nibble;
+        if (c >= '0' && c <= '9') {
+            nibble = c - '0';
+        } else if (c >= 'A' && c <= 'F') {
+            nibble = c - 'A' + 10;
+        } else if (c >= 'a' && c <= 'f') {
+            nibble = c - 'a' + 10;
+        } else {
+            return false;
+        }
+
+        for (uint8_t b = 0; b < 4; b++) {
+            if (nibble & (1u << b)) {
+                const size_t id = k * 4 + b + 1;
+                if (id > LED_COUNT) {
+                    return false;
+                }
+                led_set(mask, (uint8_t)id, true);
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Parst einen LED-Befehl und sammelt ihn im Back-Buffer
+ * @param cmd Befehl ohne Tag, z.B. "LEDON 003"
+ * @param error Fehlertext bei LED_ITEM_ERROR
+ */
+static led_item_e stage_led_item(const char *cmd, const char **error) {
+    if (strcmp(cmd, "LEDCLR") == 0) {
+        command_stage_led(LED_CMD_CLEAR, 0);
+        return LED_ITEM_OK;
+    }
+
+    if (strcmp(cmd, "LEDALL") == 0) {
+        command_stage_led(LED_CMD_ALL, 0);
+        return LED_ITEM_OK;
+    }
+
+    if (strncmp(cmd, "LEDMASK ", 8) == 0) {
+        led_bits_t mask;
+        if (!parse_led_mask(cmd + 8, mask)) {
+            *error = "INVALID_MASK";
+            return LED_ITEM_ERROR;
+        }
+        command_stage_mask(mask);
+        return LED_ITEM_OK;
+    }
+
+    // LED-Befehle mit ID
+    led_command_e led_cmd;
+    const char *arg;
+    if (strncmp(cmd, "LEDSET ", 7) == 0) {
+        led_cmd = LED_CMD_SET;
+        arg = cmd + 7;
+    } else if (strncmp(cmd, "LEDON ", 6) == 0) {
+        led_cmd = LED_CMD_ON;
+        arg = cmd + 6;
+    } else if (strncmp(cmd, "LEDOFF ", 7) == 0) {
+        led_cmd = LED_CMD_OFF;
+        arg = cmd + 7;
+    } else {
+        return LED_ITEM_UNKNOWN;
+    }
+
+    const int id = parse_id(arg);
+    if (id <= 0) {
+        *error = "INVALID_ID";
+        return LED_ITEM_ERROR;
+    }
+    command_stage_led(led_cmd, (uint8_t)id);
+    return LED_ITEM_OK;
+}
+
+/**
+ * @brief Sammelt die Eintraege einer Batch-Zeile ("LEDCLR;LEDON 003")
+ * @return false wenn die Zeile nicht mehr in den Batch passt (nichts
+ *         gesammelt)
+ */
+static bool stage_batch_line(const char *line) {
+    size_t count = 1;
+    for (const char *p = line; *p != '\0'; p++) {
+        count += (*p == ';');
+    }
+    if (_batch_items + count > SERIAL_BATCH_MAX) {
+        return false;
+    }
+
+    char buf[SERIAL_RX_LINE_LEN];
+    strncpy(buf, line, sizeof(buf) - 1);
+    buf[sizeof(buf) - 1] = '\0';
+
+    char *item = buf;
+    while (item != nullptr) {
+        char *next = strchr(item, ';');
+        if (next != nullptr) {
+            *next++ = '\0';
+        }
+
+        // Leerzeichen um den Eintrag entfernen, leere Eintraege ignorieren
+        while (*item == ' ') {
+            item++;
+        }
+        size_t len = strlen(item);
+        while (len > 0 && item[len - 1] == ' ') {
+            item[--len] = '\0';
+        }
+
+        if (len > 0) {
+            const char *error = nullptr;
+            if (stage_led_item(item, &error) != LED_ITEM_OK) {
+                _batch_errors |= 1u << _batch_items;
+            }
+            _batch_items++;
+        }
+        item = next;
+    }
+    return true;
+}
+
+/**
+ * @brief Veroeffentlicht den Batch als einen Frame und bestaetigt ihn
+ *
+ * Antwort: "BATCH <n> <fehler_hex>", mit Tag nach dem Latch
+ * "#t BATCH <n> <fehler_hex> <latch_us> <latenz_us>".
+ */
+static void commit_batch() {
+    const uint8_t items = _batch_items;
+    const uint32_t errors = _batch_errors;
+    _batch_items = 0;
+    _batch_errors = 0;
+
+    switch (command_commit_leds(_cmd_tag, false, items, errors)) {
+    case LED_COMMIT_DEFERRED:
+        return;
+    case LED_COMMIT_BUSY:
+        command_send_error("BUSY"); // Kein Eintrag uebernommen
+        return;
+    case LED_COMMIT_NOW:
+        break;
+    }
+
+    if (_cmd_tag >= 0) {
+        send_linef("#%d BATCH %u %X", (int)_cmd_tag, items, errors);
+    } else {
+        send_linef("BATCH %u %X", items, errors);
+    }
+}
+
+/**
+ * @brief Verwirft einen offenen BEGIN-Block samt gesammelter Befehle
+ */
+static void discard_batch() {
+    io_led_discard();
+    _staged_active_id = -1;
+    _batch_open = false;
+    _batch_items = 0;
+    _batch_errors = 0;
+}
+
+/**
+ * @brief Befehle, die auch in einem offenen Block sofort laufen
+ */
+static bool runs_in_batch(const char *cmd) {
+    return strcmp(cmd, "PING") == 0 || strcmp(cmd, "STATUS") == 0 ||
+           strcmp(cmd, "HELP") == 0 || strcmp(cmd, "TIME?") == 0 ||
+           strncmp(cmd, "TIME ", 5) == 0 || strncmp(cmd, "PROTO ", 6) == 0;
+}
+
+/**
+ * @brief Verarbeitet einen empfangenen Befehl (ohne Tag)
+ */
+static void execute_command(const char *cmd) {
+    if (cmd[0] == '\0') {
+        return; // Leerzeilen ignorieren
+    }
+
+    // --- Batch: BEGIN ... COMMIT bzw. "LEDCLR;LEDON 003" ---
+    if (_batch_open) {
+        _batch_ms = millis(); // Jede Zeile haelt den Block offen
+    }
+
+    if (strcmp(cmd, "COMMIT") == 0) {
+        if (!_batch_open) {
+            command_send_error("NO_BATCH");
+            return;
+        }
+        _batch_open = false;
+        commit_batch();
+        return;
+    }
+
+    if (strcmp(cmd, "ABORT") == 0) {
+        if (!_batch_open) {
+            command_send_error("NO_BATCH");
+            return;
+        }
+        discard_batch();
+        command_send_ok();
+        return;
+    }
+
+    if (strcmp(cmd, "BEGIN") == 0) {
+        if (_batch_open) {
+            command_send_error("NESTED_BATCH"); // Offener Block bleibt
+            return;
+        }
+        _batch_open = true;
+        _batch_tag = _cmd_tag;
+        _batch_ms = millis();
+        command_send_ok();
+        return;
+    }
+
+    if (_batch_open && !runs_in_batch(cmd)) {
+        // Zeilen im Block werden nur gesammelt, Antwort erst bei COMMIT
+        if (!stage_batch_line(cmd)) {
+            command_send_error("BATCH_FULL");
+        }
+        return;
+    }
+
+    if (strchr(cmd, ';') != nullptr) {
+        if (stage_batch_line(cmd)) {
+            commit_batch();
+        } else {
+            command_send_error("BATCH_FULL");
+        }
+        return;
+    }
+
+    // --- LED-Befehle: ein Frame pro Zeile ---
+    // Ohne Tag: OK sofort. Mit Tag: "#n OK <latch_us> <latenz_us>" erst
+    // nach dem Latch (Serial-Task)
+    const char *error = nullptr;
+    switch (stage_led_item(cmd, &error)) {
+    case LED_ITEM_OK:
+        switch (command_commit_leds(_cmd_tag, false, 0, 0)) {
+        case LED_COMMIT_NOW:
+            command_send_ok();
+            break;
+        case LED_COMMIT_BUSY:
+            command_send_error("BUSY");
+            break;
+        case LED_COMMIT_DEFERRED:
+            break;
+        }
+        return;
+
+    case LED_ITEM_ERROR:
+        command_send_error(error);
+        return;
+
+    case LED_ITEM_UNKNOWN:
+        break;
+    }
+
+    // --- Uebrige Befehle (Serial-Task) ---
+    if (!_hooks.execute(cmd)) {
+        command_send_error("UNKNOWN_CMD");
+    }
+}
+
+// =============================================================================
+// OEFFENTLICHE FUNKTIONEN
+// =============================================================================
+
+void command_init(const command_hooks_t &hooks) { _hooks = hooks; }
+
+void command_process(const char *line) {
+    if (line[0] != '#') {
+        execute_command(line);
+        return;
+    }
+
+    char *end = nullptr;
+    const long tag = strtol(line + 1, &end, 10);
+    if (line[1] < '0' || line[1] > '9' || *end != ' ' || tag > 65535) {
+        command_send_error("INVALID_TAG");
+        return;
+    }
+    while (*end == ' ') {
+        end++;
+    }
+
+    _cmd_tag = (int32_t)tag;
+    execute_command(end);
+    _cmd_tag = -1;
+}
+
+void command_check_timeout() {
+    if (!_batch_open || millis() - _batch_ms <= SERIAL_BATCH_TIMEOUT_MS) {
+        return;
+    }
+    discard_batch();
+    _cmd_tag = _batch_tag;
+    command_send_error("BATCH_TIMEOUT");
+    _cmd_tag = -1;
+}
+
+void command_send_ok() {
+    if (_cmd_tag >= 0) {
+        send_linef("#%d OK", (int)_cmd_tag);
+        return;
+    }
+    _hooks.send_line("OK");
+}
+
+void command_send_error(const char *msg) {
+    if (_cmd_tag >= 0) {
+        send_linef("#%d ERROR %s", (int)_cmd_tag, msg);
+        return;
+    }
+    send_linef("ERROR %s", msg);
+}
+
+void command_stage_led(led_command_e cmd, uint8_t id) {
+    if (_led_callback == nullptr) {
+        return;
+    }
+
+    _led_callback(cmd, id);
+    if (cmd == LED_CMD_SET) {
+        _staged_active_id = id;
+    } else if (cmd == LED_CMD_CLEAR) {
+        _staged_active_id = 0;
+    }
+}
+
+void command_stage_mask(const led_bits_t &mask) {
+    if (_led_mask_callback != nullptr) {
+        _led_mask_callback(mask);
+    }
+}
+
+led_commit_e command_commit_leds(int32_t tag, bool bin, uint8_t items,
+                                 uint32_t errors) {
+    // Ohne IO-Task kommt kein Latch: sofort bestaetigen
+    if (_led_callback == nullptr) {
+        tag = -1;
+    }
+
+    const led_commit_e result =
+        _hooks.commit(tag, bin, items, errors, _staged_active_id);
+    if (result == LED_COMMIT_BUSY) {
+        io_led_discard();
+    }
+    _staged_active_id = -1;
+    return result;
+}
+
+void set_led_callback(led_control_callback_t callback) {
+    _led_callback = callback;
+}
+
+void set_led_mask_callback(led_mask_callback_t callback) {
+    _led_mask_callback = callback;
+}
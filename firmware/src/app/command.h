@@ -0,0 +1,156 @@
+/**
+ * @file command.h
+ * @brief Befehlszeilen vom Pi: Tag, Batch und LED-Befehle
+ *
+ * Verantwortung:
+ * - "#n " Tag abtrennen, OK/ERROR mit Tag beantworten
+ * - LEDSET/LEDON/LEDOFF/LEDCLR/LEDALL/LEDMASK parsen und ueber die
+ *   LED-Callbacks im Back-Buffer des IO-Tasks sammeln
+ * - "cmd;cmd;..." und BEGIN ... COMMIT/ABORT als ein Frame
+ *
+ * Kein USB: Ausgabe, Commit und alle uebrigen Befehle laufen ueber
+ * command_hooks_t. Der Serial-Task haengt USB-CDC dahinter, die
+ * Host-Simulation (sim/main.cpp) ihre eigenen Pruefungen.
+ */
+#ifndef COMMAND_H
+#define COMMAND_H
+
+// =============================================================================
+// INCLUDES
+// =============================================================================
+
+#include "bitops.h"
+#include "types.h"
+
+// =============================================================================
+// TYPES
+// =============================================================================
+
+/**
+ * @brief LED-Befehle vom Pi
+ */
+typedef enum led_command {
+    LED_CMD_SET,    /**< One-hot: nur diese LED an */
+    LED_CMD_ON,     /**< Additiv: LED einschalten */
+    LED_CMD_OFF,    /**< Additiv: LED ausschalten */
+    LED_CMD_CLEAR,  /**< Alle LEDs aus */
+    LED_CMD_ALL     /**< Alle LEDs an */
+} led_command_e;
+
+/**
+ * @brief Callback-Typ fuer LED-Steuerung (implementiert in io_task)
+ * @note Laeuft im Serial-Task: baut den LED-Frame, io_led_commit()
+ *       veroeffentlicht ihn
+ */
+typedef void (*led_control_callback_t)(led_command_e cmd, uint8_t id);
+
+/**
+ * @brief Callback-Typ fuer komplette LED-Frames (implementiert in io_task)
+ */
+typedef void (*led_mask_callback_t)(const led_bits_t &mask);
+
+/**
+ * @brief Ergebnis eines LED-Commits
+ */
+typedef enum led_commit {
+    LED_COMMIT_NOW,      /**< Veroeffentlicht, sofort bestaetigen */
+    LED_COMMIT_DEFERRED, /**< Veroeffentlicht, Bestaetigung nach dem Latch */
+    LED_COMMIT_BUSY      /**< Nicht veroeffentlicht, nicht verfolgbar */
+} led_commit_e;
+
+/**
+ * @brief Anbindung an den Aufrufer (Serial-Task bzw. Simulation)
+ */
+typedef struct command_hooks {
+    /** Sendet eine Antwortzeile (ohne '\n') */
+    void (*send_line)(const char *line);
+
+    /** Uebrige Befehle (PING, STATUS, ...), false = unbekannt */
+    bool (*execute)(const char *cmd);
+
+    /**
+     * Veroeffentlicht den gesammelten Frame per io_led_commit()
+     * @param tag ASCII-Tag bzw. Binaer-seq, -1 = ohne Bestaetigung
+     * @param bin Antwort als ACK-Frame
+     * @param items Batch: Anzahl Eintraege (0 = Einzelbefehl)
+     * @param errors Batch: Fehler-Bitmap
+     * @param active_id Auswahl nach LEDSET/LEDCLR, -1 = unveraendert
+     */
+    led_commit_e (*commit)(int32_t tag, bool bin, uint8_t items,
+                           uint32_t errors, int16_t active_id);
+} command_hooks_t;
+
+// =============================================================================
+// OEFFENTLICHE FUNKTIONEN
+// =============================================================================
+
+/**
+ * @brief Setzt die Anbindung (vor der ersten Befehlszeile)
+ * @param hooks Ausgabe, uebrige Befehle, Commit (alle gesetzt)
+ */
+void command_init(const command_hooks_t &hooks);
+
+/**
+ * @brief Verarbeitet eine Befehlszeile, optional mit Tag "#n " (0-65535)
+ * @param line Zeile ohne Zeilenende
+ *
+ * Mit Tag tragen OK/ERROR das Tag ("#42 OK"), LED-Befehle werden erst
+ * nach dem Latch bestaetigt. Der Pi kann so mehrere Befehle unterwegs
+ * haben und die Antworten zuordnen.
+ */
+void command_process(const char *line);
+
+/**
+ * @brief Verwirft einen BEGIN-Block nach SERIAL_BATCH_TIMEOUT_MS ohne Zeile
+ *
+ * Antwort "ERROR BATCH_TIMEOUT" (mit dem Tag von BEGIN).
+ */
+void command_check_timeout();
+
+/**
+ * @brief Antwortet "OK" bzw. "#n OK" auf die laufende Zeile
+ */
+void command_send_ok();
+
+/**
+ * @brief Antwortet "ERROR msg" bzw. "#n ERROR msg" auf die laufende Zeile
+ */
+void command_send_error(const char *msg);
+
+/**
+ * @brief Schreibt einen LED-Befehl in den Back-Buffer des IO-Tasks
+ * @note Sichtbar erst mit command_commit_leds()
+ */
+void command_stage_led(led_command_e cmd, uint8_t id);
+
+/**
+ * @brief Schreibt einen ganzen LED-Frame in den Back-Buffer des IO-Tasks
+ */
+void command_stage_mask(const led_bits_t &mask);
+
+/**
+ * @brief Veroeffentlicht die gesammelten LED-Befehle als einen Frame
+ * @param tag ASCII-Tag bzw. Binaer-seq, -1 = ohne Tag
+ * @param bin Antwort als ACK-Frame
+ * @param items Batch: Anzahl Eintraege (0 = Einzelbefehl)
+ * @param errors Batch: Fehler-Bitmap
+ *
+ * Mit Tag nie ein OK vor dem Latch: Kann die Bestaetigung nicht
+ * verfolgt werden, wird der Frame verworfen (Aufrufer meldet BUSY).
+ */
+led_commit_e command_commit_leds(int32_t tag, bool bin, uint8_t items,
+                                 uint32_t errors);
+
+/**
+ * @brief Registriert Callback fuer LED-Befehle vom Pi
+ * @param callback Callback-Funktion
+ */
+void set_led_callback(led_control_callback_t callback);
+
+/**
+ * @brief Registriert Callback fuer LEDMASK (ganzer Frame in einem Zyklus)
+ * @param callback Callback-Funktion
+ */
+void set_led_mask_callback(led_mask_callback_t callback);
+
+#endif // COMMAND_H
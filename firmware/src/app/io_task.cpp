@@ -11,190 +11,435 @@
 
 #include "bitops.h"
 #include "config.h"
+#include "seqlock.h"
 #include "types.h"
 #include <Arduino.h>
+#include <atomic>
+#include <type_traits>
 
+#include "app/command.h"
 #include "app/serial_task.h"
 #include "drivers/cd4021.h"
+#include "drivers/duplex_scan.h"
 #include "drivers/hc595.h"
+#include "hal/scan_timer.h"
 #include "hal/spi_bus.h"
 #include "logic/debounce.h"
 #include "logic/selection.h"
+#include "logic/vertical_debounce.h"
 
 // =============================================================================
 // TYPES
 // =============================================================================
 
 /**
- * @brief LED-Befehl Struktur (fuer Queue)
+ * @brief Vom Pi gewuenschter LED-Zustand (kompletter Frame)
+ *
+ * leds ist auf der lokalen Auswahl der Generation sel gebaut. Hat der
+ * IO-Task seitdem selbst gewaehlt, ersetzt er beim Latch nur die
+ * Auswahl-LED (override_selection); alle anderen Bits gelten wie gesendet.
  */
-typedef struct led_cmd_event {
-    led_command_e cmd; /**< Befehlstyp */
-    uint8_t id;        /**< LED-ID (1-basiert) */
-} led_cmd_event_t;
+typedef struct led_frame {
+    led_bits_t leds;    /**< LED-Bits (auf Basis sel) */
+    uint32_t sel;       /**< _local_sel beim Rebase des Back-Buffers */
+    uint8_t sel_led;    /**< LED der Auswahl (0 = keine / vom Pi gesetzt) */
+    uint8_t active_id;  /**< Auswahl nach dem letzten LEDSET/LEDCLR */
+    uint8_t active_seq; /**< Zaehler der LEDSET/LEDCLR */
+    bool remote;        /**< Remote-Modus */
+    uint8_t ack;        /**< Ack-Nummer, nach dem Latch per IO_EVT_LED */
+    uint8_t commit;     /**< Laufnummer des Commits */
+} led_frame_t;
+
+/**
+ * @brief Entprell-Engine (Auswahl per DEBOUNCE_VERTICAL in config.h)
+ */
+using debounce_engine_t =
+    std::conditional<DEBOUNCE_VERTICAL, VerticalDebouncer, Debouncer>::type;
 
 // =============================================================================
 // MODUL-LOKALE VARIABLEN
 // =============================================================================
 
-static QueueHandle_t _log_queue = nullptr;
-static QueueHandle_t _led_cmd_queue = nullptr;
+static log_channel_t *_log = nullptr;
+
+// LED-Frame vom Pi: Serial-Task baut im Back-Buffer (Callbacks) und
+// veroeffentlicht per Seqlock, IO-Task uebernimmt den neuesten Frame
+static led_frame_t _led_back;        // Zuletzt veroeffentlichter Frame
+static led_frame_t _led_work;        // Befehle seit dem letzten Commit
+static Seqlock<led_frame_t> _led_front;
+static uint32_t _led_front_seen = 0; // nur IO-Task
+static uint8_t _led_ack = 0;         // Ack-Nummer des gelatchten Frames
+static uint8_t _led_commit = 0;      // Zuletzt uebernommener Commit
+static uint8_t _led_active_seq = 0;  // active_seq des gelatchten Frames
+
+// Lokale Auswahl (Generation << 16 | Commit << 8 | ID), damit der
+// Back-Buffer nachzieht; Commit = zuletzt uebernommener LED-Commit
+static std::atomic<uint32_t> _local_sel{0};
+static uint32_t _local_sel_seen = 0; // nur Serial-Task
+static bool _led_staged = false;     // _led_work gueltig, nicht committet
 
 // Hardware-Abstraktionen
 static SpiBus _spi_bus;
 static Cd4021 _buttons;
 static Hc595 _leds;
+static DuplexScan _scan;
+static ScanTimer _timer;
 
 // Logik-Module
-static Debouncer _debouncer;
+static debounce_engine_t _debouncer;
 static Selection _selection;
 
 // Zustaende
-static uint8_t _btn_raw[BTN_BYTES];
-static uint8_t _btn_raw_prev[BTN_BYTES];
-static uint8_t _btn_debounced[BTN_BYTES];
-static uint8_t _led_state[LED_BYTES];
+static btn_bits_t _btn_raw;
+static btn_bits_t _btn_raw_prev;
+static btn_bits_t _btn_debounced;
+static btn_bits_t _btn_debounced_prev;
+static led_bits_t _led_state;
 static uint8_t _active_id = 0;
 
 // Remote-Modus: Wenn true, steuert der Pi die LEDs
 static bool _remote_mode = false;
 
+// Debounce-Policy (geschrieben vom Serial-Task, uebernommen pro Zyklus)
+static std::atomic<bool> _debounce_eager{DEBOUNCE_EAGER};
+
+// Einzel-Events pro Taster-Flanke (Opt-in per Befehl EDGES ON)
+static std::atomic<bool> _edge_events{false};
+
+// Pipeline: Frame N+1 (im Transfer) und Abtastzeit von _btn_raw
+static btn_bits_t _btn_raw_next;
+static uint32_t _btn_raw_ms = 0;
+static uint32_t _btn_raw_us = 0;
+
+// Laufnummer fuer Events (Luecken = Verluste)
+static uint16_t _event_seq = 0;
+
+// Latenz-Messung: Roh-Flanken pro Taster (nur bei Roh-Aenderung gepflegt)
+static uint32_t _edge_down_us[BTN_COUNT]; // Erste Flanke des aktuellen Drucks
+static uint32_t _edge_up_us[BTN_COUNT];   // Letzte Flanke auf "losgelassen"
+
+// Taktung: letzter Tick (vTaskDelayUntil) und letzter Wakeup
+static TickType_t _last_wake = 0;
+static uint32_t _prev_wake_us = 0;
+
+// Zyklus-Auslastung (geschrieben vom IO-Task, gelesen per io_get_stats)
+static portMUX_TYPE _stats_mux = portMUX_INITIALIZER_UNLOCKED;
+static uint32_t _stats_cycles = 0;
+static uint64_t _stats_sum_us = 0;
+static uint32_t _stats_max_us = 0;
+static uint32_t _stats_overruns = 0;
+static uint64_t _stats_jitter_sum_us = 0;
+static uint32_t _stats_jitter_max_us = 0;
+static uint32_t _stats_missed = 0;
+static bool _spi_ok = true; // SpiBus::begin() (false = Treiber ohne Bus)
+static bool _timer_ok = false; // ScanTimer::begin() (false = Tick-Takt)
+
+// Laufzeit-Histogramme (nur IO-Task) und Uebergabe an PERF:
+// 0 = frei, 1 = angefordert, 2 = IO-Task kopiert, 3 = Kopie fertig
+static io_perf_t _perf;
+static io_perf_t *_perf_out = nullptr;
+static std::atomic<uint8_t> _perf_request{0};
+static uint32_t _perf_grid_us = 0; // Naechster idealer Wakeup (0 = unbekannt)
+
 // =============================================================================
 // PRIVATE HILFSFUNKTIONEN
 // =============================================================================
 
 /**
- * @brief Vergleicht zwei Arrays
- * @return true wenn identisch
+ * @brief Setzt LED-Zustand basierend auf ID (One-Hot: nur eine LED an)
+ * @param leds Ziel (_led_state oder Back-Buffer)
+ * @param id LED-ID (0 = alle aus, 1-LED_COUNT = diese LED an)
  */
-static inline bool arrays_equal(const uint8_t *a, const uint8_t *b, size_t n) {
-    for (size_t i = 0; i < n; ++i) {
-        if (a[i] != b[i]) {
-            return false;
-        }
+static void build_one_hot_led(led_bits_t &leds, uint8_t id) {
+    leds.fill(false);
+    led_set(leds, id, true); // id = 0 wird ignoriert
+}
+
+/**
+ * @brief Verbucht einen Zyklus in der Auslastungs-Statistik
+ * @param cycle_us Zeit von Wakeup bis Zyklusende
+ * @param period_us Abstand zum vorigen Wakeup (0 = erster Zyklus)
+ * @param missed Verpasste Timer-Ticks vor diesem Wakeup
+ */
+static void record_cycle(uint32_t cycle_us, uint32_t period_us,
+                         uint32_t missed) {
+    // Jitter: Abweichung des Wakeup-Abstands von der Soll-Periode
+    const uint32_t jitter_us = (period_us == 0) ? 0
+                               : (period_us > IO_PERIOD_US)
+                                   ? period_us - IO_PERIOD_US
+                                   : IO_PERIOD_US - period_us;
+
+    portENTER_CRITICAL(&_stats_mux);
+    _stats_cycles++;
+    _stats_sum_us += cycle_us;
+    if (cycle_us > _stats_max_us) {
+        _stats_max_us = cycle_us;
     }
-    return true;
+    if (cycle_us > IO_PERIOD_US) {
+        _stats_overruns++;
+    }
+    _stats_jitter_sum_us += jitter_us;
+    if (jitter_us > _stats_jitter_max_us) {
+        _stats_jitter_max_us = jitter_us;
+    }
+    _stats_missed += missed;
+    portEXIT_CRITICAL(&_stats_mux);
 }
 
 /**
- * @brief Prueft ob irgendein Taster gedrueckt
+ * @brief Liest den CPU-Zyklenzaehler (CCOUNT) fuer die Laufzeit-Histogramme
  */
-static inline bool any_pressed(const uint8_t *deb) {
-    for (size_t i = 0; i < BTN_BYTES; ++i) {
-        if (deb[i] != 0xFF) {
-            return true;
-        }
+static inline uint32_t perf_now() {
+    return IO_PERF_STATS ? ESP.getCycleCount() : 0;
+}
+
+/**
+ * @brief Verbucht die Laufzeit eines Schritts seit mark, mark = jetzt
+ * @param stage Messpunkt
+ * @param mark CCOUNT am Ende des vorigen Schritts (wird aktualisiert)
+ */
+static inline void perf_stage(io_perf_stage_e stage, uint32_t &mark) {
+    if (IO_PERF_STATS) {
+        const uint32_t now = ESP.getCycleCount();
+        _perf.stages[stage].add(now - mark);
+        mark = now;
     }
-    return false;
 }
 
 /**
- * @brief Setzt LED-Zustand basierend auf ID (One-Hot: nur eine LED an)
- * @param id LED-ID (0 = alle aus, 1-LED_COUNT = diese LED an)
+ * @brief Verbucht die Abweichung des Wakeups vom idealen Raster
+ * @param wake_us Wakeup-Zeitpunkt (micros)
+ *
+ * Raster: erster Wakeup + k * IO_PERIOD_US. Anders als IOJITTER (Abstand
+ * zum vorigen Wakeup) summiert sich hier keine Verspaetung auf. Nach
+ * verpassten Perioden rastet es auf die naechste Periode ein.
  */
-static void build_one_hot_led(uint8_t id) {
-    memset(_led_state, 0x00, LED_BYTES);
-    if (id >= 1 && id <= LED_COUNT) {
-        const uint8_t byte_idx = led_byte(id);
-        const uint8_t bit_pos = led_bit(id);
-        _led_state[byte_idx] |= (1u << bit_pos);
+static void perf_wake(uint32_t wake_us) {
+    if (!IO_PERF_STATS) {
+        return;
+    }
+    if (_perf_grid_us == 0) {
+        _perf_grid_us = wake_us + IO_PERIOD_US;
+        return;
+    }
+
+    const int32_t late = static_cast<int32_t>(wake_us - _perf_grid_us);
+    const uint32_t dev_us = (late >= 0) ? static_cast<uint32_t>(late)
+                                        : static_cast<uint32_t>(-late);
+    _perf.stages[IO_PERF_WAKE].add(dev_us * (F_CPU / 1000000UL));
+
+    _perf_grid_us += IO_PERIOD_US;
+    if (late >= static_cast<int32_t>(IO_PERIOD_US)) {
+        _perf_grid_us += (static_cast<uint32_t>(late) / IO_PERIOD_US) *
+                         IO_PERIOD_US;
     }
 }
 
 /**
- * @brief Setzt alle LEDs an
+ * @brief Uebergibt die Histogramme an einen wartenden PERF-Aufruf
+ * @note Am Zyklusende im IO-Task: Kopie ohne Lock, dann neues Fenster
  */
-static void set_all_leds() {
-    memset(_led_state, 0xFF, LED_BYTES);
-    // Ungenutzte Bits maskieren
-    if (LED_COUNT % 8 != 0) {
-        const uint8_t used_bits = LED_COUNT % 8;
-        const uint8_t mask = static_cast<uint8_t>((1u << used_bits) - 1);
-        _led_state[LED_BYTES - 1] &= mask;
+static void perf_handoff() {
+    uint8_t expected = 1;
+    if (!_perf_request.compare_exchange_strong(expected, 2,
+                                               std::memory_order_acquire)) {
+        return;
     }
+    *_perf_out = _perf;
+    for (PerfHist &hist : _perf.stages) {
+        hist.reset();
+    }
+    _perf_request.store(3, std::memory_order_release);
+}
+
+/**
+ * @brief Merkt sich die erste Roh-Flanke jedes Drucks (Latenz-Messung)
+ * @param us Abtastzeit von _btn_raw
+ *
+ * Prellen: Eine Druck-Flanke weniger als DEBOUNCE_MS nach der letzten
+ * Loslass-Flanke gehoert zum selben Druck und verschiebt den Beginn nicht.
+ * Kosten nur bei Roh-Aenderungen (wortweiser Diff).
+ */
+static void track_raw_edges(uint32_t us) {
+    btn_bits_t::diff(_btn_raw_prev, _btn_raw).for_each_set([&](uint8_t id) {
+        const size_t i = id - 1;
+        if (!activeLow_pressed(_btn_raw, id)) {
+            _edge_up_us[i] = us;
+        } else if (us - _edge_up_us[i] >= DEBOUNCE_MS * 1000) {
+            _edge_down_us[i] = us;
+        }
+    });
 }
 
 /**
- * @brief Schaltet einzelne LED ein (additiv)
+ * @brief Legt ein Event in den Log-Kanal (nicht-blockierend)
+ * @param type Event-Typ
+ * @param id Taster-/LED-ID
+ * @param us Zeitstempel der Abtastung
+ * @param edge_us Erste Roh-Flanke (nur Tastendruck, sonst 0)
+ * @return true wenn abgelegt (false = Ring voll, Verlust gezaehlt)
  */
-static void set_led_on(uint8_t id) {
-    if (id >= 1 && id <= LED_COUNT) {
-        const uint8_t byte_idx = led_byte(id);
-        const uint8_t bit_pos = led_bit(id);
-        _led_state[byte_idx] |= (1u << bit_pos);
+static bool emit_event(io_event_type_e type, uint8_t id, uint32_t us,
+                       uint32_t edge_us) {
+    io_event_t event;
+    event.us = us;
+    event.seq = _event_seq++; // auch bei Verlust: Luecke sichtbar
+    event.type = static_cast<uint8_t>(type);
+    event.id = id;
+    event.edge_us = edge_us;
+    return _log->events.push(event);
+}
+
+/**
+ * @brief Meldet eine lokale Auswahl an den Serial-Task (Back-Buffer)
+ * @param id Neue aktive ID (0 = keine)
+ */
+static void publish_local_selection(uint8_t id) {
+    const uint32_t gen =
+        ((_local_sel.load(std::memory_order_relaxed) >> 16) + 1) & 0xFFFF;
+    _local_sel.store((gen << 16) | (static_cast<uint32_t>(_led_commit) << 8) |
+                         id,
+                     std::memory_order_release);
+}
+
+/**
+ * @brief Ersetzt die Auswahl-LED eines Frames durch die lokale Auswahl
+ * @param frame Frame (Serial-Task: Back-Buffer, IO-Task: Kopie)
+ * @param id Lokale Auswahl (0 = keine)
+ *
+ * Beide Tasks rechnen gleich: Der Serial-Task zieht damit den Back-Buffer
+ * nach, der IO-Task einen Frame, der vor der Auswahl gebaut wurde.
+ */
+static void override_selection(led_frame_t &frame, uint8_t id) {
+    led_set(frame.leds, frame.sel_led, false); // 0 wird ignoriert
+    led_set(frame.leds, id, true);
+    frame.sel_led = id;
+    frame.active_id = id;
+    frame.remote = false;
+}
+
+/**
+ * @brief Zieht den Back-Buffer nach, wenn lokal gewaehlt wurde
+ * @note Laeuft im Serial-Task
+ *
+ * Hatte der IO-Task beim Tastendruck den neuesten Commit schon
+ * uebernommen, zeigt er nur die One-Hot-LED der Auswahl. Sonst latcht er
+ * danach noch einen aelteren Frame und ersetzt darin die Auswahl-LED.
+ * Nicht mitten in einem Batch: Dessen Frame traegt noch das alte sel und
+ * bekommt beim Latch denselben Override.
+ */
+static void rebase_led_back() {
+    const uint32_t sel = _local_sel.load(std::memory_order_acquire);
+    if (sel == _local_sel_seen || _led_staged) {
+        return;
     }
+    _local_sel_seen = sel;
+
+    const uint8_t id = static_cast<uint8_t>(sel & 0xFF);
+    const uint8_t seen = static_cast<uint8_t>(sel >> 8);
+    if (seen == _led_back.commit) {
+        build_one_hot_led(_led_back.leds, id);
+        _led_back.sel_led = id;
+        _led_back.active_id = id;
+        _led_back.remote = false;
+    } else {
+        override_selection(_led_back, id);
+    }
+    _led_back.sel = sel;
 }
 
 /**
- * @brief Schaltet einzelne LED aus (additiv)
+ * @brief Arbeitskopie fuer den naechsten Commit
  */
-static void set_led_off(uint8_t id) {
-    if (id >= 1 && id <= LED_COUNT) {
-        const uint8_t byte_idx = led_byte(id);
-        const uint8_t bit_pos = led_bit(id);
-        _led_state[byte_idx] &= ~(1u << bit_pos);
+static led_frame_t &led_work() {
+    rebase_led_back();
+    if (!_led_staged) {
+        _led_work = _led_back;
+        _led_staged = true;
     }
+    return _led_work;
 }
 
 /**
  * @brief LED-Callback (wird vom Serial-Task aufgerufen)
+ *
+ * Aendert nur die Arbeitskopie; veroeffentlicht wird per io_led_commit().
  */
 static void led_control_callback(led_command_e cmd, uint8_t id) {
-    if (_led_cmd_queue == nullptr) {
-        return;
+    led_frame_t &frame = led_work();
+
+    switch (cmd) {
+    case LED_CMD_SET:
+        build_one_hot_led(frame.leds, id);
+        frame.sel_led = id;
+        frame.active_id = id;
+        frame.active_seq++;
+        frame.remote = true;
+        break;
+
+    case LED_CMD_ON:
+    case LED_CMD_OFF:
+        led_set(frame.leds, id, cmd == LED_CMD_ON);
+        if (id == frame.sel_led) {
+            frame.sel_led = 0; // Pi hat die Auswahl-LED uebernommen
+        }
+        frame.remote = true;
+        break;
+
+    case LED_CMD_CLEAR:
+        frame.leds.fill(false);
+        frame.sel_led = 0;
+        frame.active_id = 0;
+        frame.active_seq++;
+        frame.remote = false; // Lokale Kontrolle wieder aktiv
+        break;
+
+    case LED_CMD_ALL:
+        // Ungenutzte Bits bleiben 0 (Maske zur Compile-Zeit)
+        frame.leds.fill(true);
+        frame.sel_led = 0;
+        frame.remote = true;
+        break;
     }
+}
 
-    led_cmd_event_t event = {cmd, id};
-    // Non-blocking: Wenn Queue voll, wird Befehl verworfen
-    xQueueSend(_led_cmd_queue, &event, 0);
+/**
+ * @brief LEDMASK-Callback (wird vom Serial-Task aufgerufen)
+ */
+static void led_mask_callback(const led_bits_t &mask) {
+    led_frame_t &frame = led_work();
+
+    frame.leds = mask;
+    frame.sel_led = 0;
+    frame.remote = true;
 }
 
 /**
- * @brief LED-Befehle verarbeiten (aus Queue)
+ * @brief Uebernimmt den neuesten LED-Frame vom Pi
  * @return true wenn LED-Zustand geaendert
+ *
+ * Wartet nie: Schreibt der Serial-Task gerade (von diesem Task
+ * unterbrochen), wird der Frame im naechsten Zyklus abgeholt.
  */
-static bool process_led_commands() {
-    led_cmd_event_t event;
-    bool led_changed = false;
-
-    // Alle wartenden Befehle verarbeiten
-    while (xQueueReceive(_led_cmd_queue, &event, 0) == pdTRUE) {
-        switch (event.cmd) {
-        case LED_CMD_SET:
-            build_one_hot_led(event.id);
-            _active_id = event.id;
-            _remote_mode = true;
-            led_changed = true;
-            break;
-
-        case LED_CMD_ON:
-            set_led_on(event.id);
-            _remote_mode = true;
-            led_changed = true;
-            break;
-
-        case LED_CMD_OFF:
-            set_led_off(event.id);
-            _remote_mode = true;
-            led_changed = true;
-            break;
-
-        case LED_CMD_CLEAR:
-            memset(_led_state, 0x00, LED_BYTES);
-            _active_id = 0;
-            _remote_mode = false; // Lokale Kontrolle wieder aktiv
-            led_changed = true;
-            break;
-
-        case LED_CMD_ALL:
-            set_all_leds();
-            _remote_mode = true;
-            led_changed = true;
-            break;
-        }
+static bool process_led_frame() {
+    led_frame_t frame;
+    if (!_led_front.read(frame, _led_front_seen)) {
+        return false;
     }
 
-    return led_changed;
+    // Lokal gewaehlt nach dem Rebase: Pi-Bits gelten, die Auswahl bleibt
+    const uint32_t sel = _local_sel.load(std::memory_order_relaxed);
+    if (frame.sel != sel) {
+        override_selection(frame, static_cast<uint8_t>(sel & 0xFF));
+    } else if (frame.active_seq != _led_active_seq) {
+        _active_id = frame.active_id; // Auswahl aendern nur LEDSET/LEDCLR
+    }
+    _led_state = frame.leds;
+    _remote_mode = frame.remote;
+    _led_active_seq = frame.active_seq;
+    _led_commit = frame.commit;
+    _led_ack = frame.ack;
+    return true;
 }
 
 // =============================================================================
@@ -202,13 +447,12 @@ static bool process_led_commands() {
 // =============================================================================
 
 /**
- * @brief Hauptschleife des IO-Tasks
+ * @brief Initialisierung des IO-Tasks (einmalig, vor dem ersten Zyklus)
  */
-static void io_task_function(void *) {
-    // -------------------------------------------------------------------------
-    // Initialisierung (einmalig)
-    // -------------------------------------------------------------------------
-    _spi_bus.begin(PIN_SCK, PIN_BTN_MISO, PIN_LED_MOSI);
+static void io_task_init() {
+    // Ohne Bus laufen Zyklus und Serial weiter (STATUS meldet SPI FAIL),
+    // Treiber nehmen ihren Bus-Fehler-Pfad
+    _spi_ok = _spi_bus.begin(PIN_SCK, PIN_BTN_MISO, PIN_LED_MOSI);
 
     _buttons.init();
     _leds.init();
@@ -218,95 +462,227 @@ static void io_task_function(void *) {
 
     // LED-Callback registrieren
     set_led_callback(led_control_callback);
+    set_led_mask_callback(led_mask_callback);
 
     // Alle Taster als "losgelassen" initialisieren
-    memset(_btn_raw, 0xFF, BTN_BYTES);
-    memset(_btn_raw_prev, 0xFF, BTN_BYTES);
-    memset(_btn_debounced, 0xFF, BTN_BYTES);
-    memset(_led_state, 0x00, LED_BYTES);
+    _btn_raw.fill(true);
+    _btn_raw_next.fill(true);
+    _btn_raw_prev.fill(true);
+    _btn_debounced.fill(true);
+    _btn_debounced_prev.fill(true);
+    _led_state.fill(false);
 
     _active_id = 0;
-    build_one_hot_led(_active_id);
+    build_one_hot_led(_led_state, _active_id);
     _leds.write(_spi_bus, _led_state);
 
     // Fuer praezises Timing: Startzeit merken
-    TickType_t last_wake = xTaskGetTickCount();
+    _last_wake = xTaskGetTickCount();
+    _btn_raw_ms = millis();
+    _btn_raw_us = micros();
+    for (size_t i = 0; i < BTN_COUNT; i++) {
+        _edge_down_us[i] = _btn_raw_us;
+        _edge_up_us[i] = _btn_raw_us - DEBOUNCE_MS * 1000;
+    }
+
+    // Timer-Takt: ISR weckt diesen Task (Registrierung auf CORE_APP).
+    // Ohne Timer wuerde wait() ewig blockieren: Rueckfall auf den Tick
+    // (STATUS meldet TIMER FAIL)
+    _timer_ok = IO_TIMER_SCAN && _timer.begin(IO_TIMER_PERIOD_US);
+    _prev_wake_us = 0;
+}
+
+/**
+ * @brief Ein IO-Zyklus: Warten auf die Periode, dann Schritte 0-5
+ */
+static void io_task_cycle() {
+    // Warten bis naechste Periode (kompensiert Ausfuehrungszeit)
+    uint32_t missed = 0;
+    if (_timer_ok) {
+        const uint32_t ticks = _timer.wait();
+        missed = (ticks > 1) ? ticks - 1 : 0;
+    } else {
+        // Tick-Takt, Timer-Periode unter 1 ms aufgerundet
+        vTaskDelayUntil(&_last_wake,
+                        pdMS_TO_TICKS((IO_PERIOD_US + 999) / 1000));
+    }
+    const uint32_t cycle_start_us = micros();
+    const uint32_t wake_period_us =
+        (_prev_wake_us != 0) ? cycle_start_us - _prev_wake_us : 0;
+    _prev_wake_us = cycle_start_us;
+    perf_wake(cycle_start_us);
+    const uint32_t perf_start = perf_now();
+    uint32_t perf_mark = perf_start;
 
     // -------------------------------------------------------------------------
-    // Hauptschleife (endlos)
+    // 0. Neuesten LED-Frame vom Pi uebernehmen
     // -------------------------------------------------------------------------
-    for (;;) {
-        // Warten bis naechste Periode (kompensiert Ausfuehrungszeit)
-        vTaskDelayUntil(&last_wake, pdMS_TO_TICKS(IO_PERIOD_MS));
+    bool led_cmd_processed = process_led_frame();
+    perf_stage(IO_PERF_LED_CMD, perf_mark);
 
-        // ---------------------------------------------------------------------
-        // 0. LED-Befehle vom Pi verarbeiten
-        // ---------------------------------------------------------------------
-        bool led_cmd_processed = process_led_commands();
-
-        // ---------------------------------------------------------------------
-        // 1. Taster einlesen
-        // ---------------------------------------------------------------------
+    // -------------------------------------------------------------------------
+    // 1. Taster einlesen
+    // -------------------------------------------------------------------------
+    // Full-Duplex: Derselbe Transfer schreibt den aktuellen LED-Frame
+    // (inkl. LED-Befehlen aus Schritt 0) und latcht ihn.
+    // Pipeline: Transfer fuer Frame N+1 nur starten, Schritte 2-3
+    // rechnen auf Frame N aus dem vorigen Zyklus.
+    uint32_t now = millis();
+    uint32_t now_us = micros();
+    bool scan_pending = false;
+
+    if (IO_PIPELINED) {
+        scan_pending = _scan.start(_spi_bus, _buttons, _led_state);
+        const uint32_t sample_ms = now;
+        const uint32_t sample_us = now_us;
+        now = _btn_raw_ms; // Abtastzeit von Frame N
+        now_us = _btn_raw_us;
+        _btn_raw_ms = sample_ms;
+        _btn_raw_us = sample_us;
+    } else if (SCAN_FULL_DUPLEX) {
+        _scan.transfer(_spi_bus, _buttons, _leds, _led_state, _btn_raw);
+    } else {
         _buttons.readRaw(_spi_bus, _btn_raw);
-        const bool raw_changed =
-            !arrays_equal(_btn_raw, _btn_raw_prev, BTN_BYTES);
-
-        // ---------------------------------------------------------------------
-        // 2. Entprellen
-        // ---------------------------------------------------------------------
-        const uint32_t now = millis();
-        const bool deb_changed =
-            _debouncer.update(now, _btn_raw, _btn_debounced);
-
-        // ---------------------------------------------------------------------
-        // 3. Auswahl aktualisieren
-        // ---------------------------------------------------------------------
-        const bool active_changed =
-            _selection.update(_btn_debounced, _active_id);
-
-        // ---------------------------------------------------------------------
-        // 4. LEDs aktualisieren
-        // ---------------------------------------------------------------------
-        // Lokaler Tastendruck beendet Remote-Modus und uebernimmt Kontrolle
-        if (active_changed && _active_id > 0) {
-            _remote_mode = false;
-            build_one_hot_led(_active_id);
-        }
-        // Ohne Remote-Modus: LEDs folgen lokaler Auswahl
-        else if (active_changed && !_remote_mode) {
-            build_one_hot_led(_active_id);
-        }
+    }
+    const bool raw_changed = (_btn_raw != _btn_raw_prev);
+    if (raw_changed) {
+        track_raw_edges(now_us);
+    }
+    perf_stage(IO_PERF_BTN_READ, perf_mark);
 
-        // LED-Hardware aktualisieren
-        if (LED_REFRESH_EVERY_CYCLE || led_cmd_processed || active_changed) {
+    // -------------------------------------------------------------------------
+    // 2. Entprellen
+    // -------------------------------------------------------------------------
+    _debouncer.setEager(_debounce_eager.load(std::memory_order_relaxed));
+    const bool deb_changed =
+        _debouncer.update(now, _btn_raw, _btn_debounced);
+    perf_stage(IO_PERF_DEBOUNCE, perf_mark);
+
+    // -------------------------------------------------------------------------
+    // 3. Auswahl aktualisieren
+    // -------------------------------------------------------------------------
+    const bool active_changed =
+        _selection.update(_btn_debounced, _active_id);
+    perf_stage(IO_PERF_SELECTION, perf_mark);
+
+    // -------------------------------------------------------------------------
+    // 4. LEDs aktualisieren
+    // -------------------------------------------------------------------------
+    // Lokaler Tastendruck beendet Remote-Modus und uebernimmt Kontrolle
+    if (active_changed && _active_id > 0) {
+        _remote_mode = false;
+        build_one_hot_led(_led_state, _active_id);
+        publish_local_selection(_active_id);
+    }
+    // Ohne Remote-Modus: LEDs folgen lokaler Auswahl
+    else if (active_changed && !_remote_mode) {
+        build_one_hot_led(_led_state, _active_id);
+        publish_local_selection(_active_id);
+    }
+
+    // Pipeline: Transfer abholen (latcht den Frame aus Schritt 1)
+    if (scan_pending) {
+        _scan.finish(_spi_bus, _leds, _btn_raw_next);
+    }
+
+    // LED-Hardware aktualisieren
+    // Full-Duplex: Frame wurde in Schritt 1 bereits geschrieben; nur eine
+    // neue lokale Auswahl wird sofort nachgeschoben (sonst +1 Zyklus)
+    if (SCAN_FULL_DUPLEX) {
+        if (active_changed) {
             _leds.write(_spi_bus, _led_state);
         }
+    } else if (LED_REFRESH_EVERY_CYCLE || led_cmd_processed ||
+               active_changed) {
+        _leds.write(_spi_bus, _led_state);
+    }
+    perf_stage(IO_PERF_LED_WRITE, perf_mark);
 
-        // ---------------------------------------------------------------------
-        // 5. Log-Event erstellen und senden
-        // ---------------------------------------------------------------------
-        const bool should_log =
-            deb_changed || active_changed || (LOG_ON_RAW_CHANGE && raw_changed);
-
-        const bool not_empty = any_pressed(_btn_debounced) || active_changed;
-
-        if (should_log && not_empty && _log_queue != nullptr) {
-            log_event_t event = {};
-            event.ms = now;
-            memcpy(event.raw, _btn_raw, BTN_BYTES);
-            memcpy(event.deb, _btn_debounced, BTN_BYTES);
-            memcpy(event.led, _led_state, LED_BYTES);
-            event.active_id = _active_id;
-            event.raw_changed = raw_changed;
-            event.deb_changed = deb_changed;
-            event.active_changed = active_changed;
-
-            // Nicht-blockierend: Bei voller Queue wird Event verworfen
-            xQueueSend(_log_queue, &event, 0);
-        }
+    // -------------------------------------------------------------------------
+    // 5. Events erstellen und senden
+    // -------------------------------------------------------------------------
+    // Kompakte Events: Kosten skalieren mit Flanken, nicht mit BTN_COUNT
+    bool notify = false;
+
+    // Multi-Touch: Ein Event pro entprellter Flanke (wortweiser Diff)
+    if (_log != nullptr && deb_changed &&
+        _edge_events.load(std::memory_order_relaxed)) {
+        btn_bits_t::diff(_btn_debounced_prev, _btn_debounced)
+            .for_each_set([&](uint8_t id) {
+                const bool pressed = activeLow_pressed(_btn_debounced, id);
+                notify |= emit_event(pressed ? IO_EVT_PRESS : IO_EVT_RELEASE,
+                                     id, now_us,
+                                     pressed ? _edge_down_us[id - 1] : 0);
+            });
+    }
+    if (deb_changed) {
+        _btn_debounced_prev = _btn_debounced;
+    }
+
+    if (_log != nullptr && active_changed) {
+        notify |= emit_event(IO_EVT_ACTIVE, _active_id, now_us,
+                             _active_id > 0 ? _edge_down_us[_active_id - 1]
+                                            : 0);
+    }
+
+    // LED-Frame vom Pi ist jetzt gelatcht: Ack-Nummer + Zeitpunkt fuer
+    // die Bestaetigung ("#n OK <us>" bzw. ACK-Frame)
+    if (_log != nullptr && led_cmd_processed) {
+        notify |= emit_event(IO_EVT_LED, _led_ack, micros(), 0);
+    }
+
+    // Volle Snapshots nur fuer die Debug-Ausgabe
+    const bool should_log =
+        deb_changed || active_changed || (LOG_ON_RAW_CHANGE && raw_changed);
+
+    const bool not_empty = activeLow_any(_btn_debounced) || active_changed;
+
+    if (!SERIAL_PROTOCOL_ONLY && should_log && not_empty &&
+        _log != nullptr) {
+        log_event_t event = {};
+        event.ms = now;
+        event.raw = _btn_raw;
+        event.deb = _btn_debounced;
+        event.led = _led_state;
+        event.active_id = _active_id;
+        event.raw_changed = raw_changed;
+        event.deb_changed = deb_changed;
+        event.active_changed = active_changed;
+
+        // Lock-frei: Bei vollem Ring zaehlt der Ring den Verlust
+        notify |= _log->snapshots.push(event);
+    }
+
+    if (notify) {
+        notify_serial_task();
+    }
+    perf_stage(IO_PERF_LOG, perf_mark);
+
+    // Raw-Zustand fuer naechsten Zyklus merken
+    _btn_raw_prev = _btn_raw;
+
+    // Pipeline: Frame N+1 wird im naechsten Zyklus verarbeitet
+    if (IO_PIPELINED) {
+        _btn_raw = _btn_raw_next;
+    }
+
+    record_cycle(micros() - cycle_start_us, wake_period_us, missed);
+
+    if (IO_PERF_STATS) {
+        perf_mark = perf_start;
+        perf_stage(IO_PERF_CYCLE, perf_mark);
+        perf_handoff();
+    }
+}
+
+/**
+ * @brief Hauptschleife des IO-Tasks
+ */
+static void io_task_function(void *) {
+    io_task_init();
 
-        // Raw-Zustand fuer naechsten Zyklus merken
-        memcpy(_btn_raw_prev, _btn_raw, BTN_BYTES);
+    for (;;) {
+        io_task_cycle();
     }
 }
 
@@ -314,12 +690,110 @@ static void io_task_function(void *) {
 // OEFFENTLICHE FUNKTIONEN
 // =============================================================================
 
-void start_io_task(QueueHandle_t log_queue) {
-    _log_queue = log_queue;
+void io_get_stats(io_stats_t *out) {
+    portENTER_CRITICAL(&_stats_mux);
+    out->cycles = _stats_cycles;
+    out->avg_us = (_stats_cycles > 0)
+                      ? static_cast<uint32_t>(_stats_sum_us / _stats_cycles)
+                      : 0;
+    out->max_us = _stats_max_us;
+    out->budget_us = IO_PERIOD_US;
+    out->overruns = _stats_overruns;
+    out->jitter_avg_us =
+        (_stats_cycles > 0)
+            ? static_cast<uint32_t>(_stats_jitter_sum_us / _stats_cycles)
+            : 0;
+    out->jitter_max_us = _stats_jitter_max_us;
+    out->missed = _stats_missed;
+    out->spi_ok = _spi_ok;
+    out->timer_ok = _timer_ok;
+
+    // Neues Messfenster
+    _stats_cycles = 0;
+    _stats_sum_us = 0;
+    _stats_max_us = 0;
+    _stats_overruns = 0;
+    _stats_jitter_sum_us = 0;
+    _stats_jitter_max_us = 0;
+    _stats_missed = 0;
+    portEXIT_CRITICAL(&_stats_mux);
+}
 
-    // LED-Befehls-Queue erstellen
-    _led_cmd_queue = xQueueCreate(8, sizeof(led_cmd_event_t));
+bool io_get_perf(io_perf_t *out) {
+    if (!IO_PERF_STATS) {
+        return false;
+    }
+
+    // Kopie legt der IO-Task am Zyklusende an (kein Lock im Messpfad)
+    _perf_out = out;
+    _perf_request.store(1, std::memory_order_release);
+
+    const TickType_t start = xTaskGetTickCount();
+    const TickType_t limit = pdMS_TO_TICKS(4 * IO_PERIOD_US / 1000 + 1);
+    for (;;) {
+        if (_perf_request.load(std::memory_order_acquire) == 3) {
+            _perf_request.store(0, std::memory_order_relaxed);
+            return true;
+        }
+        if (xTaskGetTickCount() - start > limit) {
+            // Noch nicht abgeholt: Anforderung zuruecknehmen
+            uint8_t expected = 1;
+            if (_perf_request.compare_exchange_strong(expected, 0)) {
+                return false;
+            }
+        }
+        vTaskDelay(1);
+    }
+}
+
+bool io_set_debounce_eager(bool eager) {
+    // Vertikaler Zaehler kennt nur die zeitbasierte Policy
+    if (DEBOUNCE_VERTICAL && eager) {
+        return false;
+    }
+    _debounce_eager.store(eager, std::memory_order_relaxed);
+    return true;
+}
+
+void io_set_edge_events(bool enabled) {
+    _edge_events.store(enabled, std::memory_order_relaxed);
+}
+
+bool io_edge_events() { return _edge_events.load(std::memory_order_relaxed); }
+
+void io_led_commit(uint8_t ack) {
+    rebase_led_back(); // Nichts gesammelt: aktuellen Stand bestaetigen
+    if (_led_staged) {
+        _led_back = _led_work;
+        _led_staged = false;
+    }
+    _led_back.commit++;
+    _led_back.ack = ack;
+    _led_front.write(_led_back);
+}
+
+void io_led_discard() {
+    _led_staged = false; // _led_back ist erst beim Commit geaendert
+}
+
+bool io_debounce_eager() {
+    return _debounce_eager.load(std::memory_order_relaxed);
+}
+
+void start_io_task(log_channel_t *log) {
+    _log = log;
 
     xTaskCreatePinnedToCore(io_task_function, "IO", 8192, nullptr, PRIO_IO,
                             nullptr, CORE_APP);
 }
+
+#if NATIVE_SIM
+void io_sim_begin(log_channel_t *log) {
+    _log = log;
+    io_task_init();
+}
+
+void io_sim_cycle() { io_task_cycle(); }
+
+uint8_t io_sim_active_id() { return _active_id; }
+#endif
@@ -11,8 +11,13 @@
  * - LED-Befehle vom Pi verarbeiten (ueber Callback)
  *
  * Warum eigener Task?
- * vTaskDelayUntil() garantiert konstante 5 ms Periode.
+ * vTaskDelayUntil() bzw. ScanTimer (IO_TIMER_SCAN) garantiert konstante
+ * Periode.
  * Unabhaengig von Serial-Ausgabe (die blockieren kann).
+ *
+ * Pipeline (IO_PIPELINED=true):
+ * Der SPI-Transfer fuer Frame N+1 laeuft, waehrend die Logik Frame N
+ * verarbeitet. Events kommen damit hoechstens einen Zyklus spaeter.
  */
 #ifndef IO_TASK_H
 #define IO_TASK_H
@@ -21,8 +26,53 @@
 // INCLUDES
 // =============================================================================
 
+#include "perf_hist.h"
+#include "types.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/queue.h"
+#include <Arduino.h>
+
+// =============================================================================
+// TYPES
+// =============================================================================
+
+/**
+ * @brief Auslastung und Jitter des IO-Zyklus (Zeitbudget IO_PERIOD_US)
+ */
+typedef struct io_stats {
+    uint32_t cycles;    /**< Zyklen im Messfenster */
+    uint32_t avg_us;    /**< Mittlere Zykluszeit (Wakeup bis Ende) */
+    uint32_t max_us;    /**< Laengste Zykluszeit */
+    uint32_t budget_us; /**< Verfuegbares Budget (IO_PERIOD_US) */
+    uint32_t overruns;  /**< Zyklen laenger als das Budget */
+    uint32_t jitter_avg_us; /**< Mittlere Abweichung Wakeup-Abstand */
+    uint32_t jitter_max_us; /**< Groesste Abweichung Wakeup-Abstand */
+    uint32_t missed;        /**< Verpasste Timer-Ticks (IO_TIMER_SCAN) */
+    bool spi_ok;            /**< SPI-Bus initialisiert (SpiBus::begin) */
+    bool timer_ok;          /**< ScanTimer laeuft (false = Tick-Rueckfall) */
+} io_stats_t;
+
+/**
+ * @brief Messpunkte der IO-Laufzeit-Histogramme (IO_PERF_STATS)
+ */
+typedef enum io_perf_stage {
+    IO_PERF_LED_CMD = 0, /**< 0. LED-Frame vom Pi uebernehmen */
+    IO_PERF_BTN_READ,    /**< 1. Taster einlesen (SPI) */
+    IO_PERF_DEBOUNCE,    /**< 2. Entprellen */
+    IO_PERF_SELECTION,   /**< 3. Auswahl */
+    IO_PERF_LED_WRITE,   /**< 4. LEDs schreiben (inkl. Pipeline-Abholung) */
+    IO_PERF_LOG,         /**< 5. Events/Snapshots + Notify */
+    IO_PERF_CYCLE,       /**< Schritte 0-5 inkl. Statistik */
+    IO_PERF_WAKE,        /**< |Wakeup - ideales Raster| */
+    IO_PERF_COUNT
+} io_perf_stage_e;
+
+/**
+ * @brief Kopie der Histogramme eines Messfensters (CPU-Takte)
+ */
+typedef struct io_perf {
+    PerfHist stages[IO_PERF_COUNT]; /**< Index = io_perf_stage_e */
+} io_perf_t;
 
 // =============================================================================
 // OEFFENTLICHE FUNKTIONEN
@@ -30,8 +80,82 @@
 
 /**
  * @brief Startet den IO-Task auf CORE_APP mit PRIO_IO
- * @param log_queue Queue fuer Log-Events
+ * @param log Log-Kanal (IO-Task ist einziger Producer)
+ */
+void start_io_task(log_channel_t *log);
+
+/**
+ * @brief Liest die Zyklus-Auslastung und startet ein neues Messfenster
+ * @param out Ziel fuer die Statistik
+ */
+void io_get_stats(io_stats_t *out);
+
+/**
+ * @brief Holt die Laufzeit-Histogramme und startet ein neues Messfenster
+ * @param out Ziel (gross: nicht auf einen kleinen Stack legen)
+ * @return false wenn IO_PERF_STATS aus ist oder der IO-Task nicht antwortet
+ * @note Blockiert bis zum Ende des naechsten IO-Zyklus (Kopie im IO-Task)
+ */
+bool io_get_perf(io_perf_t *out);
+
+/**
+ * @brief Waehlt die Press-Policy des Debouncers (Leading-Edge oder zeitbasiert)
+ * @param eager true = Press sofort, danach DEBOUNCE_LOCKOUT_MS Sperre
+ * @return false wenn die Entprell-Engine das nicht unterstuetzt
+ * @note Wird im naechsten IO-Zyklus wirksam (thread-sicher)
+ */
+bool io_set_debounce_eager(bool eager);
+
+/**
+ * @brief Schaltet Einzel-Events pro Taster-Flanke (IO_EVT_PRESS/RELEASE)
+ * @param enabled true = jede entprellte Flanke melden (Multi-Touch)
+ * @note Wird im naechsten IO-Zyklus wirksam (thread-sicher)
+ */
+void io_set_edge_events(bool enabled);
+
+/**
+ * @brief Liefert, ob Einzel-Events pro Taster-Flanke aktiv sind
+ * @return true wenn aktiv
+ */
+bool io_edge_events();
+
+/**
+ * @brief Liefert die angeforderte Press-Policy
+ * @return true wenn Leading-Edge aktiv
+ */
+bool io_debounce_eager();
+
+/**
+ * @brief Veroeffentlicht den per LED-Callbacks gebauten Frame (ein Latch)
+ * @param ack Ack-Nummer (kumulativ), kommt nach dem Latch per IO_EVT_LED
+ * @note Nur aus dem Serial-Task; ein Aufruf pro Befehl bzw. Batch
+ */
+void io_led_commit(uint8_t ack);
+
+/**
+ * @brief Verwirft die seit dem letzten io_led_commit() gesammelten Befehle
+ * @note Nur aus dem Serial-Task (z.B. Bestaetigung nicht verfolgbar)
+ */
+void io_led_discard();
+
+#if NATIVE_SIM
+/**
+ * @brief Initialisiert den IO-Zustand ohne Task (Host-Simulation)
+ * @param log Log-Kanal (Aufrufer ist Consumer)
+ */
+void io_sim_begin(log_channel_t *log);
+
+/**
+ * @brief Fuehrt genau einen IO-Zyklus im Aufrufer aus (Host-Simulation)
+ * @note vTaskDelayUntil() stellt dort nur die simulierte Uhr vor
+ */
+void io_sim_cycle();
+
+/**
+ * @brief Aktuelle Auswahl des IO-Tasks (Host-Simulation)
+ * @return Aktive ID (0 = keine)
  */
-void start_io_task(QueueHandle_t log_queue);
+uint8_t io_sim_active_id();
+#endif
 
 #endif // IO_TASK_H
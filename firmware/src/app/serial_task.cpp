@@ -4,9 +4,22 @@
  *
  * Problem: USB-CDC kann Nachrichten fragmentieren (z.B. "PRE" + "SS 001\n")
  * Loesung:
- *   1. Komplette Zeile als ein write() senden (nicht printf)
- *   2. Kurzer Delay nach flush() damit USB-Paket abgeschlossen wird
+ *   1. Ganze Zeilen in 64-Byte-Paketen sammeln (CdcLineWriter),
+ *      eine Zeile liegt nie in zwei Paketen
+ *   2. Paket senden wenn voll oder im Leerlauf (kein Delay pro Zeile)
  *   3. Server hat zusaetzlich Fragment-Timeout
+ *
+ * Senden uebernimmt der TX-Task (tx_task.*): dieser Task legt Zeilen nur
+ * in den Stream-Buffer und blockiert nie im USB-Stack.
+ *
+ * Empfang: USB-CDC RX-Callback weckt diesen Task (SERIAL_RX_EVENTS),
+ * Befehle werden sofort geparst statt im 10-ms-Raster.
+ *
+ * "PROTO BIN" schaltet auf das binaere Protokoll (bin_proto.h) um:
+ * Events als typisierte COBS-Frames, ASCII-Antworten als TEXT-Frames.
+ *
+ * SERIAL_TX_COALESCE=false: alter Pfad (flush + 2 ms pro Zeile),
+ * TXBENCH vergleicht beide Pfade auf dem Geraet.
  */
 
 // =============================================================================
@@ -14,32 +27,97 @@
 // =============================================================================
 
 #include "app/serial_task.h"
+#include "app/command.h"
+#include "app/io_task.h"
+#include "app/bin_proto.h"
+#include "app/tx_task.h"
 
 #include "bitops.h"
 #include "config.h"
 #include "types.h"
 #include <Arduino.h>
+#include <atomic>
 
+#include "esp_timer.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/queue.h"
 #include "freertos/task.h"
 
+// =============================================================================
+// TYPES
+// =============================================================================
+
+/**
+ * @brief LED-Befehl, dessen Bestaetigung auf den Latch wartet
+ */
+typedef struct pending_ack {
+    uint32_t rx_us;  /**< RX-Meldung des Befehls (fuer Latenz) */
+    uint32_t errors; /**< Batch: Fehler-Bitmap (Bit 0 = Eintrag 1) */
+    uint16_t tag;    /**< ASCII: #n, Binaer: seq des Befehls */
+    uint8_t ack;     /**< Ack-Nummer des Frames mit diesem Befehl */
+    uint8_t items;   /**< Batch: Anzahl Eintraege, 0 = Einzelbefehl */
+    bool bin;        /**< Antwort als ACK-Frame statt "#n OK" */
+} pending_ack_t;
+
+/**
+ * @brief Eine Messung des Uhrabgleichs (TIME t1 t2 t3)
+ */
+typedef struct time_sample {
+    int64_t pi_us;     /**< Pi-Zeit in der Mitte der Messung ((t1+t3)/2) */
+    int64_t offset_us; /**< ESP32-Uhr minus Pi-Uhr */
+    uint32_t rtt_us;   /**< Round-Trip am Pi (t3 - t1) */
+} time_sample_t;
+
 // =============================================================================
 // MODUL-LOKALE VARIABLEN
 // =============================================================================
 
-static QueueHandle_t _log_queue = nullptr;
-static led_control_callback_t _led_callback = nullptr;
+static log_channel_t *_log = nullptr;
+static TaskHandle_t _task = nullptr;
 
 // Letzter aktiver Button (fuer RELEASE-Erkennung)
 static uint8_t _last_active_id = 0;
 
 // Serial-Eingabepuffer
-static char _rx_buffer[64];
+static char _rx_buffer[SERIAL_RX_LINE_LEN];
 static size_t _rx_index = 0;
 
-// TX-Puffer fuer atomische Sends
-static char _tx_buffer[64];
+// TX-Puffer fuer atomische Sends (laengere Zeilen: mehrere USB-Pakete)
+static char _tx_buffer[128];
+static uint32_t _tx_truncated = 0; // send_linef() ueber _tx_buffer (TXQ)
+
+// RX-Statistik (STATUS/RXQ)
+static uint32_t _rx_high_water = 0; // Max. Serial.available() beim Lesen
+static uint32_t _rx_overruns = 0;   // Verworfene Zeilen (Puffer voll)
+
+// Zeitpunkt der letzten RX-Meldung (Callback bzw. Poll), fuer RTT
+static std::atomic<uint32_t> _rx_event_us{0};
+
+// Latenz-Messung: PRESS mit Korrelations-ID und Zeitstempeln (TRACE ON)
+static bool _trace_press = false;
+
+// Binaeres Protokoll (PROTO BIN), nach Reset immer ASCII
+static bool _proto_bin = false;
+static uint8_t _bin_seq = 0;                // Laufnummer ESP32 → Pi
+static uint8_t _rx_frame[BIN_FRAME_MAX];    // Kodierter Frame bis 0x00
+static size_t _rx_frame_len = 0;
+static uint32_t _rx_frames = 0;             // Gueltige Frames
+static uint32_t _rx_frame_errors = 0;       // COBS/CRC/Laenge fehlerhaft
+
+// Bestaetigungen nach dem Latch (FIFO in Befehlsreihenfolge)
+static pending_ack_t _pending_acks[SERIAL_ACK_PENDING];
+static uint8_t _pending_head = 0;
+static uint8_t _pending_count = 0;
+static uint8_t _ack_issued = 0; // Ack-Nummer des zuletzt verfolgten Befehls
+static_assert(SERIAL_ACK_PENDING < 128, "Ack-Vergleich braucht FIFO < 128");
+
+// Uhrabgleich mit dem Pi: Ring der letzten Messungen (TIME t1 t2 t3)
+static time_sample_t _time_samples[SERIAL_TIME_SAMPLES];
+static uint8_t _time_head = 0;  // Naechster Schreibplatz
+static uint8_t _time_count = 0; // Gueltige Messungen
+
+// PERF: Kopie der IO-Histogramme (statisch, zu gross fuer den Task-Stack)
+static io_perf_t _perf_dump;
 
 // =============================================================================
 // PRIVATE DEBUG HILFSFUNKTIONEN
@@ -74,16 +152,16 @@ static void print_byte_array(const char *label, const uint8_t *arr,
 /**
  * @brief Gibt Liste der gedrueckten Taster aus
  */
-static void print_pressed_list(const uint8_t *deb) {
+static void print_pressed_list(const btn_bits_t &deb) {
     Serial.print("Pressed: ");
-    bool any = false;
-    for (uint8_t id = 1; id <= BTN_COUNT; ++id) {
-        if (activeLow_pressed(deb, id)) {
-            Serial.printf("%u ", id);
-            any = true;
-        }
-    }
-    if (!any) {
+
+    // Active-Low: gedrueckt = 0 -> invertieren, dann gesetzte Bits iterieren
+    btn_bits_t released;
+    released.fill(true);
+    const btn_bits_t pressed = btn_bits_t::diff(deb, released);
+    pressed.for_each_set([](uint8_t id) { Serial.printf("%u ", id); });
+
+    if (!pressed.any()) {
         Serial.print('-');
     }
     Serial.println();
@@ -92,9 +170,11 @@ static void print_pressed_list(const uint8_t *deb) {
 /**
  * @brief Gibt detaillierte Taster-Info aus
  */
-static void print_buttons_verbose(const uint8_t *raw, const uint8_t *deb) {
+static void print_buttons_verbose(const btn_bits_t &raw,
+                                  const btn_bits_t &deb) {
     Serial.println("Buttons per ID (RAW/DEB)  [pressed=1 | released=0]");
-    for (uint8_t id = 1; id <= BTN_COUNT; ++id) {
+    for (size_t i = 0; i < BTN_COUNT; ++i) {
+        const uint8_t id = static_cast<uint8_t>(i + 1);
         Serial.printf("  T%02u  IC%u b%u   RAW=%u  DEB=%u\n", id,
                       (unsigned)btn_byte(id), (unsigned)btn_bit(id),
                       activeLow_pressed(raw, id) ? 1u : 0u,
@@ -105,9 +185,10 @@ static void print_buttons_verbose(const uint8_t *raw, const uint8_t *deb) {
 /**
  * @brief Gibt detaillierte LED-Info aus
  */
-static void print_leds_verbose(const uint8_t *led) {
+static void print_leds_verbose(const led_bits_t &led) {
     Serial.println("LEDs per ID (STATE)  [on=1 | off=0]");
-    for (uint8_t id = 1; id <= LED_COUNT; ++id) {
+    for (size_t i = 0; i < LED_COUNT; ++i) {
+        const uint8_t id = static_cast<uint8_t>(i + 1);
         Serial.printf("  LED%02u  IC%u b%u   STATE=%u\n", id,
                       (unsigned)led_byte(id), (unsigned)led_bit(id),
                       led_on(led, id) ? 1u : 0u);
@@ -118,25 +199,71 @@ static void print_leds_verbose(const uint8_t *led) {
 // PRIVATE SERIAL AUSGABE
 // =============================================================================
 
+/**
+ * @brief Sendet einen Binaer-Frame (nur PROTO BIN)
+ * @param op Opcode
+ * @param seq Laufnummer (eigene bzw. die des Befehls bei ACK/PONG)
+ */
+static void send_frame(uint8_t op, uint8_t seq, const uint8_t *payload,
+                       size_t len) {
+    uint8_t frame[BIN_FRAME_MAX];
+    const size_t n = bin_encode(op, seq, payload, len, frame);
+    tx_send(frame, n); // Verlust bei vollem Buffer: STATUS/TXQ
+}
+
+/**
+ * @brief Sendet ein Taster-Event als Frame: [id][us32 LE]
+ */
+static void send_event_frame(uint8_t op, uint8_t id, uint32_t us) {
+    const uint8_t payload[5] = {id, (uint8_t)us, (uint8_t)(us >> 8),
+                                (uint8_t)(us >> 16), (uint8_t)(us >> 24)};
+    send_frame(op, _bin_seq++, payload, sizeof(payload));
+}
+
+/**
+ * @brief Schreibt einen uint32 little-endian (Frame-Nutzdaten)
+ */
+static uint8_t *put_le32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+    return p + 4;
+}
+
 /**
  * @brief Sendet eine Zeile atomar ueber USB-CDC
- * @note USB-CDC hat 64-Byte Pakete, printf kann fragmentieren
+ * @note Legt die Zeile nur in den Stream-Buffer, TX-Task sendet paketweise.
+ *       Mit PROTO BIN als TEXT-Frame (ohne '\n').
  */
 static void send_line(const char *line) {
-    Serial.print(line);
-    Serial.print('\n');
-    Serial.flush();
-    delayMicroseconds(2000); // 2ms USB-CDC Paket abschliessen lassen
+    if (_proto_bin) {
+        // Lange Zeilen in Teilstuecken statt auf BIN_PAYLOAD_MAX gekuerzt
+        const uint8_t *text = reinterpret_cast<const uint8_t *>(line);
+        size_t len = strlen(line);
+        while (len > BIN_PAYLOAD_MAX) {
+            send_frame(BIN_OP_TEXT_MORE, _bin_seq++, text, BIN_PAYLOAD_MAX);
+            text += BIN_PAYLOAD_MAX;
+            len -= BIN_PAYLOAD_MAX;
+        }
+        send_frame(BIN_OP_TEXT, _bin_seq++, text, len);
+        return;
+    }
+    tx_send_line(line); // Verlust bei vollem Buffer: STATUS/TXQ
 }
 
 /**
  * @brief Formatiert und sendet eine Zeile atomar
+ * @note Laenger als _tx_buffer: gekuerzt gesendet, gezaehlt in TXQ
  */
 static void send_linef(const char *fmt, ...) {
     va_list args;
     va_start(args, fmt);
-    vsnprintf(_tx_buffer, sizeof(_tx_buffer), fmt, args);
+    const int n = vsnprintf(_tx_buffer, sizeof(_tx_buffer), fmt, args);
     va_end(args);
+    if (n >= (int)sizeof(_tx_buffer)) {
+        _tx_truncated++;
+    }
     send_line(_tx_buffer);
 }
 
@@ -146,15 +273,16 @@ static void send_linef(const char *fmt, ...) {
 
 static void send_pong() { send_line("PONG"); }
 
-static void send_ok() { send_line("OK"); }
-
-static void send_error(const char *msg) { send_linef("ERROR %s", msg); }
-
 static void send_version() { send_line("FW selection-panel v2.5.1"); }
 
 static void send_help() {
     send_line("Commands: PING, STATUS, VERSION, HELP");
     send_line("          LEDSET n, LEDON n, LEDOFF n, LEDCLR, LEDALL");
+    send_line("          LEDMASK hex");
+    send_line("          DEBOUNCE EAGER|CONFIRM, EDGES ON|OFF, TRACE ON|OFF");
+    send_line("          TXBENCH n, RTT token, PERF");
+    send_line("          TIME?, TIME t1 t2 t3");
+    send_line("          #n cmd, cmd;cmd;..., BEGIN/COMMIT/ABORT");
 }
 
 static void send_status() {
@@ -162,137 +290,612 @@ static void send_status() {
     send_linef("BTNS %u", BTN_COUNT);
     send_linef("LEDS %u", LED_COUNT);
     send_linef("HEAP %u", ESP.getFreeHeap());
+
+    // IO-Auslastung seit dem letzten STATUS: avg/max gegen das Zyklusbudget
+    io_stats_t io;
+    io_get_stats(&io);
+    send_linef("IOLOAD %u %u %u %u", io.avg_us, io.max_us, io.budget_us,
+               io.overruns);
+    send_linef("IOJITTER %u %u %u", io.jitter_avg_us, io.jitter_max_us,
+               io.missed);
+    send_linef("SPI %s", io.spi_ok ? "OK" : "FAIL");
+    send_linef("TIMER %s", !IO_TIMER_SCAN ? "OFF"
+                           : io.timer_ok  ? "OK"
+                                          : "FAIL");
+    // Event-Ring: Hoechststand, Verluste, Kapazitaet (seit Start)
+    send_linef("LOGQ %u %u %u", _log->events.highWater(),
+               _log->events.overflows(), (unsigned)LOG_QUEUE_LEN);
+    // USB pro Richtung: Fuellstand, Hoechststand, Stalls/Verluste
+    tx_stats_t tx;
+    tx_get_stats(&tx);
+    send_linef("TXQ %u %u %u %u %u %u", tx.depth, tx.high_water, tx.stalls,
+               tx.drops, tx.capacity, _tx_truncated);
+    send_linef("RXQ %u %u %u", (unsigned)Serial.available(), _rx_high_water,
+               _rx_overruns);
+    send_linef("DEBOUNCE %s", io_debounce_eager() ? "EAGER" : "CONFIRM");
+    send_linef("EDGES %s", io_edge_events() ? "ON" : "OFF");
+    send_linef("TRACE %s", _trace_press ? "ON" : "OFF");
+    send_linef("PROTO %s %u %u", _proto_bin ? "BIN" : "ASCII", _rx_frames,
+               _rx_frame_errors);
     send_linef("MODE %s", BTN_COUNT <= 10 ? "PROTOTYPE" : "PRODUCTION");
-    send_ok();
+    command_send_ok();
 }
 
-static void send_press(uint8_t id) { send_linef("PRESS %03u", id); }
+/**
+ * @brief Gibt die IO-Laufzeit pro Schritt aus und startet ein neues Fenster
+ *
+ * Eine Zeile pro Messpunkt: "PERF <name> <n> <min> <avg> <p99> <max>" in ns
+ * (p99 auf Bucket-Genauigkeit, siehe perf_hist.h)
+ */
+static void send_perf() {
+    static const char *const names[IO_PERF_COUNT] = {
+        "LEDCMD", "READ", "DEBOUNCE", "SELECT",
+        "LEDWRITE", "LOG", "CYCLE", "WAKE"};
 
-static void send_release(uint8_t id) { send_linef("RELEASE %03u", id); }
+    if (!io_get_perf(&_perf_dump)) {
+        command_send_error(IO_PERF_STATS ? "TIMEOUT" : "NOT_SUPPORTED");
+        return;
+    }
+
+    // CPU-Takte -> ns (64 Bit: 5 ms sind 1,2 Mio. Takte)
+    constexpr uint32_t cpu_mhz = F_CPU / 1000000UL;
+    auto ns = [](uint32_t cycles) {
+        return static_cast<unsigned>(static_cast<uint64_t>(cycles) * 1000 /
+                                     cpu_mhz);
+    };
+    for (size_t i = 0; i < IO_PERF_COUNT; i++) {
+        const PerfHist &hist = _perf_dump.stages[i];
+        send_linef("PERF %s %u %u %u %u %u", names[i], hist.count(),
+                   ns(hist.min()), ns(hist.avg()), ns(hist.percentile(990)),
+                   ns(hist.max()));
+    }
+    command_send_ok();
+}
+
+/**
+ * @brief Schaetzt Offset und Drift aus dem Messfenster
+ * @param pi_us Pi-Zeit, fuer die der Offset gilt
+ * @param offset_us Ziel: ESP32-Uhr minus Pi-Uhr zu pi_us
+ * @param drift_ppb Ziel: Gang der ESP32-Uhr gegen die Pi-Uhr (ppb)
+ * @return Messung mit der kuerzesten Round-Trip (Bezugspunkt)
+ * @note Nur mit _time_count > 0 aufrufen
+ */
+static const time_sample_t &time_estimate(int64_t pi_us, int64_t *offset_us,
+                                          int32_t *drift_ppb) {
+    // Bezugspunkt: kuerzeste Round-Trip = kleinster Fehler (+-rtt/2)
+    const time_sample_t *best = &_time_samples[0];
+    for (uint8_t i = 1; i < _time_count; i++) {
+        if (_time_samples[i].rtt_us < best->rtt_us) {
+            best = &_time_samples[i];
+        }
+    }
+
+    // Drift: Regressionsgerade Offset ueber Pi-Zeit (relativ zu best,
+    // damit double die Mikrosekunden nicht verliert)
+    double sx = 0, sy = 0, sxx = 0, sxy = 0;
+    for (uint8_t i = 0; i < _time_count; i++) {
+        const double x = (double)(_time_samples[i].pi_us - best->pi_us);
+        const double y = (double)(_time_samples[i].offset_us - best->offset_us);
+        sx += x;
+        sy += y;
+        sxx += x * x;
+        sxy += x * y;
+    }
+    const double n = _time_count;
+    const double denom = n * sxx - sx * sx;
+    double slope = (_time_count >= 2 && denom > 0)
+                       ? (n * sxy - sx * sy) / denom
+                       : 0.0;
+    // Quarz: wenige 10 ppm; mehr ist eine gestoerte Messung
+    if (slope > 1e-3 || slope < -1e-3) {
+        slope = 0.0;
+    }
+
+    *drift_ppb = (int32_t)(slope * 1e9);
+    *offset_us =
+        best->offset_us + (int64_t)(slope * (double)(pi_us - best->pi_us));
+    return *best;
+}
+
+/**
+ * @brief Antwort auf TIME?: ESP32-Zeit fuer eine Messung (t2)
+ * @note 64 Bit ohne Ueberlauf; die unteren 32 Bit sind micros(), also
+ *       dieselbe Uhr wie die Event-Zeitstempel
+ */
+static void send_time_stamp() {
+    send_linef("TIME %lld", (long long)esp_timer_get_time());
+}
+
+/**
+ * @brief Verbucht eine Messung "TIME t1 t2 t3" und meldet Offset/Drift
+ * @param args "t1 t2 t3": Pi sendet TIME? (t1, Pi-Uhr), ESP32-Zeit aus der
+ *             Antwort (t2), Pi empfaengt die Antwort (t3, Pi-Uhr)
+ *
+ * Wie NTP mit einem ESP32-Zeitpunkt: t2 liegt im Mittel in der Mitte der
+ * Round-Trip, Offset = t2 - (t1 + t3) / 2, Fehler hoechstens rtt/2.
+ * Antwort: "TIME <offset_us> <drift_ppb> <rtt_us> <messungen>"
+ */
+static void handle_time_sample(const char *args) {
+    char *end = nullptr;
+    const long long t1 = strtoll(args, &end, 10);
+    const bool ok1 = (end != args && *end == ' ');
+    const char *next = end;
+    const long long t2 = strtoll(next, &end, 10);
+    const bool ok2 = (end != next && *end == ' ');
+    next = end;
+    const long long t3 = strtoll(next, &end, 10);
+    const bool ok3 = (end != next && *end == '\0');
+
+    // Round-Trip muss positiv und plausibel sein (USB: wenige ms)
+    if (!ok1 || !ok2 || !ok3 || t3 < t1 || t3 - t1 > 1000000) {
+        command_send_error("INVALID_TIME");
+        return;
+    }
+
+    time_sample_t sample;
+    sample.pi_us = t1 + (t3 - t1) / 2;
+    sample.offset_us = t2 - sample.pi_us;
+    sample.rtt_us = (uint32_t)(t3 - t1);
+
+    // Sprung gegenueber der Vorhersage: neuer Host, Fenster verwerfen
+    if (_time_count > 0) {
+        int64_t predicted = 0;
+        int32_t drift = 0;
+        time_estimate(sample.pi_us, &predicted, &drift);
+        const int64_t jump = sample.offset_us - predicted;
+        const int64_t limit = SERIAL_TIME_RESET_US;
+        if (jump > limit || jump < -limit) {
+            _time_count = 0;
+            _time_head = 0;
+        }
+    }
+
+    _time_samples[_time_head] = sample;
+    _time_head = (_time_head + 1) % SERIAL_TIME_SAMPLES;
+    if (_time_count < SERIAL_TIME_SAMPLES) {
+        _time_count++;
+    }
+
+    int64_t offset_us = 0;
+    int32_t drift_ppb = 0;
+    const time_sample_t &best =
+        time_estimate(sample.pi_us, &offset_us, &drift_ppb);
+    send_linef("TIME %lld %ld %u %u", (long long)offset_us, (long)drift_ppb,
+               best.rtt_us, _time_count);
+}
+
+/**
+ * @brief Meldet eine neue Auswahl (PRESS)
+ *
+ * Mit TRACE ON zusaetzlich Korrelations-ID (Event-Laufnummer), erste
+ * Roh-Flanke, Entprell-Bestaetigung und Sendezeitpunkt (alle micros()),
+ * damit Pi und Browser ihre Zeitstempel anhaengen koennen.
+ */
+static void send_press(const io_event_t &event) {
+    const uint32_t tx_us = micros();
+    if (_proto_bin) {
+        if (!_trace_press) {
+            // Ohne vsnprintf
+            send_event_frame(BIN_OP_PRESS, event.id, event.us);
+            return;
+        }
+        // [id][us32][pid16][edge32][tx32]
+        uint8_t payload[15];
+        uint8_t *p = payload;
+        *p++ = event.id;
+        p = put_le32(p, event.us);
+        *p++ = (uint8_t)event.seq;
+        *p++ = (uint8_t)(event.seq >> 8);
+        p = put_le32(p, event.edge_us);
+        put_le32(p, tx_us);
+        send_frame(BIN_OP_PRESS, _bin_seq++, payload, sizeof(payload));
+        return;
+    }
+    if (_trace_press) {
+        send_linef("PRESS %03u %u %u %u %u", event.id, event.seq,
+                   event.edge_us, event.us, tx_us);
+        return;
+    }
+    send_linef("PRESS %03u", event.id);
+}
+
+static void send_release(uint8_t id, uint32_t us) {
+    if (_proto_bin) {
+        send_event_frame(BIN_OP_RELEASE, id, us);
+        return;
+    }
+    send_linef("RELEASE %03u", id);
+}
+
+static void send_edge(bool down, uint8_t id, uint32_t us) {
+    if (_proto_bin) {
+        send_event_frame(down ? BIN_OP_DOWN : BIN_OP_UP, id, us);
+        return;
+    }
+    send_linef("%s %03u %u", down ? "DOWN" : "UP", id, us);
+}
+
+/**
+ * @brief TX-Benchmark: n Zeilen ueber alten und neuen Sendepfad
+ *
+ * Ausgabe (nach den BENCH-Zeilen):
+ *   TXBENCH LEGACY <n> <us>
+ *   TXBENCH COALESCE <n> <us> <pakete>
+ *
+ * <us> = Blockierzeit des Serial-Tasks fuer n Zeilen.
+ * Empfangsseite: firmware/tools/tx_bench.py
+ */
+static void send_tx_bench(uint16_t n) {
+    tx_bench_result_t result = {};
+    tx_bench(n, &result);
+
+    send_linef("TXBENCH LEGACY %u %u", n, result.legacy_us);
+    send_linef("TXBENCH COALESCE %u %u %u", n, result.coalesce_us,
+               result.packets);
+}
 
 // =============================================================================
 // PRIVATE BEFEHLSVERARBEITUNG (Pi -> ESP32)
 // =============================================================================
 
+static void handle_event(const io_event_t &event);
+
 /**
- * @brief Parst eine ID (001-100) aus einem String
- * @return ID (1-LED_COUNT) oder -1 bei Fehler
+ * @brief Merkt die Bestaetigung eines LED-Befehls fuer nach dem Latch vor
+ * @param tag ASCII-Tag bzw. Binaer-seq
+ * @param bin Antwort als ACK-Frame
+ * @param items Batch: Anzahl Eintraege (0 = Einzelbefehl)
+ * @param errors Batch: Fehler-Bitmap
+ * @return false wenn die FIFO voll bleibt (IO-Task latcht nicht)
+ * @note Vor io_led_commit() aufrufen: Der Frame traegt _ack_issued
+ *
+ * FIFO voll: Events abarbeiten, bis der IO-Task latcht. Solange wird
+ * USB-RX nicht gelesen (Gegendruck bis zum Host).
  */
-static int parse_id(const char *str) {
-    while (*str == ' ') {
-        str++; // Leerzeichen ueberspringen
-    }
-    int id = atoi(str);
-    if (id >= 1 && id <= LED_COUNT) {
-        return id;
+static bool defer_led_ack(uint16_t tag, bool bin, uint8_t items,
+                          uint32_t errors) {
+    // Der zuletzt veroeffentlichte Frame ist nach wenigen Zyklen gelatcht
+    const TickType_t start = xTaskGetTickCount();
+    const TickType_t limit = pdMS_TO_TICKS(4 * IO_PERIOD_US / 1000 + 1);
+    io_event_t event;
+    while (_pending_count >= SERIAL_ACK_PENDING) {
+        if (xTaskGetTickCount() - start > limit) {
+            return false;
+        }
+        ulTaskNotifyTake(pdTRUE, 1);
+        while (_log->events.pop(event)) {
+            handle_event(event);
+        }
     }
-    return -1;
+
+    _ack_issued++;
+    pending_ack_t &entry =
+        _pending_acks[(_pending_head + _pending_count) % SERIAL_ACK_PENDING];
+    entry.rx_us = _rx_event_us.load(std::memory_order_relaxed);
+    entry.errors = errors;
+    entry.tag = tag;
+    entry.ack = _ack_issued;
+    entry.items = items;
+    entry.bin = bin;
+    _pending_count++;
+    return true;
 }
 
 /**
- * @brief Verarbeitet einen empfangenen Befehl
+ * @brief Veroeffentlicht den gesammelten LED-Frame (command_hooks_t)
+ * @param tag ASCII-Tag bzw. Binaer-seq, -1 = ohne Tag
+ * @param bin Antwort als ACK-Frame
+ * @param items Batch: Anzahl Eintraege (0 = Einzelbefehl)
+ * @param errors Batch: Fehler-Bitmap
+ * @param active_id Auswahl nach LEDSET/LEDCLR (CURLED), -1 = unveraendert
+ *
+ * Mit Tag nie ein OK vor dem Latch: Kann die Bestaetigung nicht
+ * verfolgt werden, bleibt der Frame unveroeffentlicht (BUSY).
  */
-static void process_command(const char *cmd) {
-    if (cmd[0] == '\0') {
-        return; // Leerzeilen ignorieren
+static led_commit_e commit_led_frame(int32_t tag, bool bin, uint8_t items,
+                                     uint32_t errors, int16_t active_id) {
+    const bool tracked = tag >= 0;
+    if (tracked && !defer_led_ack((uint16_t)tag, bin, items, errors)) {
+        return LED_COMMIT_BUSY;
+    }
+
+    io_led_commit(_ack_issued);
+    if (active_id >= 0) {
+        _last_active_id = (uint8_t)active_id;
     }
+    return tracked ? LED_COMMIT_DEFERRED : LED_COMMIT_NOW;
+}
 
+/**
+ * @brief Befehle des Serial-Tasks (command_hooks_t)
+ * @param cmd Befehl ohne Tag
+ * @return false wenn unbekannt
+ *
+ * Tag, Batch und LED-Befehle parst command.cpp vorher.
+ */
+static bool execute_command(const char *cmd) {
     // --- Einfache Befehle ---
     if (strcmp(cmd, "PING") == 0) {
         send_pong();
-        return;
+        return true;
     }
 
     if (strcmp(cmd, "VERSION") == 0) {
         send_version();
-        return;
+        return true;
     }
 
     if (strcmp(cmd, "HELP") == 0) {
         send_help();
-        return;
+        return true;
     }
 
     if (strcmp(cmd, "STATUS") == 0) {
         send_status();
-        return;
+        return true;
     }
 
-    // --- LED-Befehle ohne ID ---
-    if (strcmp(cmd, "LEDCLR") == 0) {
-        if (_led_callback != nullptr) {
-            _led_callback(LED_CMD_CLEAR, 0);
-            _last_active_id = 0;
-        }
-        send_ok();
-        return;
+    if (strcmp(cmd, "PERF") == 0) {
+        send_perf();
+        return true;
     }
 
-    if (strcmp(cmd, "LEDALL") == 0) {
-        if (_led_callback != nullptr) {
-            _led_callback(LED_CMD_ALL, 0);
+    // --- Entprell-Policy ---
+    if (strcmp(cmd, "DEBOUNCE EAGER") == 0 ||
+        strcmp(cmd, "DEBOUNCE CONFIRM") == 0) {
+        if (io_set_debounce_eager(cmd[9] == 'E')) {
+            command_send_ok();
+        } else {
+            command_send_error("NOT_SUPPORTED");
         }
-        send_ok();
-        return;
+        return true;
     }
 
-    // --- LED-Befehle mit ID ---
-    if (strncmp(cmd, "LEDSET ", 7) == 0) {
-        int id = parse_id(cmd + 7);
-        if (id > 0) {
-            if (_led_callback != nullptr) {
-                _led_callback(LED_CMD_SET, (uint8_t)id);
-                _last_active_id = (uint8_t)id;
-            }
-            send_ok();
+    // --- Einzel-Events pro Taster (Multi-Touch) ---
+    if (strcmp(cmd, "EDGES ON") == 0 || strcmp(cmd, "EDGES OFF") == 0) {
+        io_set_edge_events(cmd[7] == 'N');
+        command_send_ok();
+        return true;
+    }
+
+    // --- Latenz-Messung: PRESS mit Korrelations-ID + Zeitstempeln ---
+    if (strcmp(cmd, "TRACE ON") == 0 || strcmp(cmd, "TRACE OFF") == 0) {
+        _trace_press = (cmd[7] == 'N');
+        command_send_ok();
+        return true;
+    }
+
+    // --- Uhrabgleich mit dem Pi (NTP-artig) ---
+    if (strcmp(cmd, "TIME?") == 0) {
+        send_time_stamp();
+        return true;
+    }
+
+    if (strncmp(cmd, "TIME ", 5) == 0) {
+        handle_time_sample(cmd + 5);
+        return true;
+    }
+
+    // --- TX-Benchmark (alter vs. neuer Sendepfad) ---
+    if (strncmp(cmd, "TXBENCH ", 8) == 0) {
+        if (_proto_bin) {
+            // Alter Pfad schreibt rohes ASCII an Serial vorbei an den
+            // Frames: der COBS-Strom des Pi waere danach zerrissen
+            command_send_error("NOT_SUPPORTED");
+            return true;
+        }
+        int n = atoi(cmd + 8);
+        if (n >= 1 && n <= 1000) {
+            send_tx_bench((uint16_t)n);
+            command_send_ok();
         } else {
-            send_error("INVALID_ID");
+            command_send_error("INVALID_COUNT");
         }
-        return;
+        return true;
     }
 
-    if (strncmp(cmd, "LEDON ", 6) == 0) {
-        int id = parse_id(cmd + 6);
-        if (id > 0) {
-            if (_led_callback != nullptr) {
-                _led_callback(LED_CMD_ON, (uint8_t)id);
-            }
-            send_ok();
-        } else {
-            send_error("INVALID_ID");
+    // --- Protokoll-Umschaltung ---
+    if (strcmp(cmd, "PROTO BIN") == 0) {
+        if (!SERIAL_PROTOCOL_ONLY) {
+            // Debug-Ausgaben sind ASCII
+            command_send_error("NOT_SUPPORTED");
+            return true;
         }
+        // Letzte ASCII-Zeile, danach nur noch Frames (auch im Fehlerfall
+        // an der Zeile erkennbar, nicht an einem OK)
+        send_line("PROTO BIN");
+        _proto_bin = true;
+        _rx_index = 0;
+        return true;
+    }
+
+    if (strcmp(cmd, "PROTO ASCII") == 0) {
+        send_line("PROTO ASCII"); // Bei BIN: letzter TEXT-Frame
+        _proto_bin = false;
+        _rx_frame_len = 0;
+        return true;
+    }
+
+    // --- Round-Trip-Messung: Echo + Zeit von RX-Meldung bis Antwort ---
+    if (strncmp(cmd, "RTT ", 4) == 0) {
+        const uint32_t rx_us = _rx_event_us.load(std::memory_order_relaxed);
+        send_linef("RTT %.24s %u", cmd + 4, micros() - rx_us);
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * @brief Veroeffentlicht einen Binaer-LED-Befehl (ACK nach dem Latch)
+ */
+static bin_status_e commit_led_bin(uint8_t seq, bool &deferred) {
+    switch (command_commit_leds(seq, true, 0, 0)) {
+    case LED_COMMIT_DEFERRED:
+        deferred = true;
+        return BIN_STATUS_OK;
+    case LED_COMMIT_BUSY:
+        return BIN_STATUS_BUSY;
+    case LED_COMMIT_NOW:
+        break;
+    }
+    return BIN_STATUS_OK;
+}
+
+/**
+ * @brief Fuehrt einen LED-Befehl aus (Binaer-Protokoll)
+ * @param seq Laufnummer des Befehls (fuer den ACK-Frame)
+ * @param deferred true = ACK kommt erst nach dem Latch
+ * @return Status fuer den ACK-Frame (BUSY: Befehl verworfen)
+ */
+static bin_status_e apply_led_command(led_command_e cmd, uint8_t id,
+                                      uint8_t seq, bool &deferred) {
+    const bool needs_id =
+        (cmd == LED_CMD_SET || cmd == LED_CMD_ON || cmd == LED_CMD_OFF);
+    if (needs_id && (id < 1 || id > LED_COUNT)) {
+        return BIN_STATUS_INVALID_ID;
+    }
+
+    command_stage_led(cmd, id);
+    return commit_led_bin(seq, deferred);
+}
+
+/**
+ * @brief Verarbeitet einen gueltigen Frame vom Pi
+ */
+static void process_frame(const bin_frame_t &frame) {
+    uint8_t status = BIN_STATUS_OK;
+    bool deferred = false;
+    const uint8_t id = frame.len > 0 ? frame.payload[0] : 0;
+
+    switch (frame.op) {
+    case BIN_OP_PING:
+        send_frame(BIN_OP_PONG, frame.seq, nullptr, 0);
+        return;
+
+    case BIN_OP_CMD_TEXT: {
+        // ASCII-Befehl im Frame: Antworten kommen als TEXT-Frames
+        char cmd[BIN_PAYLOAD_MAX + 1];
+        memcpy(cmd, frame.payload, frame.len);
+        cmd[frame.len] = '\0';
+        command_process(cmd);
         return;
     }
 
-    if (strncmp(cmd, "LEDOFF ", 7) == 0) {
-        int id = parse_id(cmd + 7);
-        if (id > 0) {
-            if (_led_callback != nullptr) {
-                _led_callback(LED_CMD_OFF, (uint8_t)id);
+    case BIN_OP_LEDSET:
+    case BIN_OP_LEDON:
+    case BIN_OP_LEDOFF:
+        if (frame.len != 1) {
+            status = BIN_STATUS_BAD_LENGTH;
+            break;
+        }
+        status = apply_led_command(
+            frame.op == BIN_OP_LEDSET  ? LED_CMD_SET
+            : frame.op == BIN_OP_LEDON ? LED_CMD_ON
+                                       : LED_CMD_OFF,
+            id, frame.seq, deferred);
+        break;
+
+    case BIN_OP_LEDCLR:
+        status = apply_led_command(LED_CMD_CLEAR, 0, frame.seq, deferred);
+        break;
+
+    case BIN_OP_LEDALL:
+        status = apply_led_command(LED_CMD_ALL, 0, frame.seq, deferred);
+        break;
+
+    case BIN_OP_LEDMASK: {
+        // Payload = led_bits_t-Bytes (Byte 0 Bit 0 = LED 1)
+        if (frame.len == 0 || frame.len > LED_BYTES) {
+            status = BIN_STATUS_BAD_LENGTH;
+            break;
+        }
+        led_bits_t mask;
+        for (size_t i = 0; i < frame.len * 8; i++) {
+            if ((frame.payload[i / 8] >> (i % 8)) & 1u) {
+                if (i >= LED_COUNT) {
+                    status = BIN_STATUS_INVALID_ID;
+                    break;
+                }
+                led_set(mask, (uint8_t)(i + 1), true);
             }
-            send_ok();
-        } else {
-            send_error("INVALID_ID");
         }
+        if (status == BIN_STATUS_OK) {
+            command_stage_mask(mask);
+            status = commit_led_bin(frame.seq, deferred);
+        }
+        break;
+    }
+
+    default:
+        status = BIN_STATUS_UNKNOWN_OP;
+        break;
+    }
+
+    // LED-Befehle: ACK mit Latch-Zeit folgt in handle_led_applied()
+    if (!deferred) {
+        send_frame(BIN_OP_ACK, frame.seq, &status, 1);
+    }
+}
+
+/**
+ * @brief Sammelt Frame-Bytes bis 0x00 (PROTO BIN)
+ *
+ * Selbstsynchronisierend: Ein kaputter oder zu langer Frame wird bis zum
+ * naechsten 0x00 verworfen, der Frame danach ist wieder gueltig.
+ */
+static void read_binary_byte(uint8_t c) {
+    if (c != 0x00) {
+        if (_rx_frame_len < sizeof(_rx_frame)) {
+            _rx_frame[_rx_frame_len] = c;
+        }
+        _rx_frame_len++; // Ueberlange Frames zaehlen weiter, s.u.
         return;
     }
 
-    // Unbekannter Befehl
-    send_error("UNKNOWN_CMD");
+    if (_rx_frame_len == 0) {
+        return; // Leerer Frame (doppeltes 0x00): ignorieren
+    }
+
+    uint8_t decoded[BIN_FRAME_MAX];
+    bin_frame_t frame;
+    if (_rx_frame_len <= sizeof(_rx_frame) &&
+        bin_decode(_rx_frame, _rx_frame_len, decoded, &frame)) {
+        _rx_frames++;
+        process_frame(frame);
+    } else {
+        _rx_frame_errors++;
+    }
+    _rx_frame_len = 0;
 }
 
 /**
  * @brief Liest Serial-Eingabe (non-blocking)
  */
 static void read_serial_input() {
+    const uint32_t pending = Serial.available();
+    if (pending > _rx_high_water) {
+        _rx_high_water = pending;
+    }
+
+    // Ohne RX-Callback zaehlt fuer RTT der Zeitpunkt des Polls
+    if (!SERIAL_RX_EVENTS && pending > 0) {
+        _rx_event_us.store(micros(), std::memory_order_relaxed);
+    }
+
     while (Serial.available()) {
         char c = Serial.read();
 
+        if (_proto_bin) {
+            read_binary_byte((uint8_t)c);
+            continue;
+        }
+
         // Zeilenende erkannt
         if (c == '\n' || c == '\r') {
             if (_rx_index > 0) {
                 _rx_buffer[_rx_index] = '\0';
-                process_command(_rx_buffer);
+                command_process(_rx_buffer);
                 _rx_index = 0;
             }
         }
@@ -303,10 +906,132 @@ static void read_serial_input() {
         // Puffer voll -> verwerfen und neu starten
         else {
             _rx_index = 0;
+            _rx_overruns++;
+        }
+    }
+}
+
+// =============================================================================
+// PRIVATE EVENT-VERARBEITUNG (ESP32 -> Pi)
+// =============================================================================
+
+/**
+ * @brief Bestaetigt alle LED-Befehle, die im gelatchten Frame stecken
+ * @param ack Ack-Nummer des Frames (kumulativ)
+ * @param us Zeitpunkt nach dem Latch
+ *
+ * Antwort: "#n OK <latch_us> <latenz_us>" bzw. ACK-Frame
+ * [status][latch_us u32][latenz_us u32], Latenz = RX-Meldung bis Latch.
+ */
+static void handle_led_applied(uint8_t ack, uint32_t us) {
+    while (_pending_count > 0) {
+        const pending_ack_t &entry = _pending_acks[_pending_head];
+        // Ack-Nummern laufen ueber: Vergleich relativ (FIFO << 128)
+        if ((int8_t)(uint8_t)(ack - entry.ack) < 0) {
+            break; // Steckt erst in einem spaeteren Frame
+        }
+
+        const uint32_t latency_us = us - entry.rx_us;
+        if (entry.bin) {
+            const uint8_t payload[9] = {
+                BIN_STATUS_OK,           (uint8_t)us,
+                (uint8_t)(us >> 8),      (uint8_t)(us >> 16),
+                (uint8_t)(us >> 24),     (uint8_t)latency_us,
+                (uint8_t)(latency_us >> 8), (uint8_t)(latency_us >> 16),
+                (uint8_t)(latency_us >> 24)};
+            send_frame(BIN_OP_ACK, (uint8_t)entry.tag, payload,
+                       sizeof(payload));
+        } else if (entry.items > 0) {
+            send_linef("#%u BATCH %u %X %u %u", entry.tag, entry.items,
+                       entry.errors, us, latency_us);
+        } else {
+            send_linef("#%u OK %u %u", entry.tag, us, latency_us);
+        }
+
+        _pending_head = (_pending_head + 1) % SERIAL_ACK_PENDING;
+        _pending_count--;
+    }
+}
+
+/**
+ * @brief Setzt ein kompaktes Event in Protokoll- bzw. Debug-Ausgabe um
+ */
+static void handle_event(const io_event_t &event) {
+    // LED-Frame gelatcht: wartende Bestaetigungen senden
+    if (event.type == IO_EVT_LED) {
+        handle_led_applied(event.id, event.us);
+        return;
+    }
+
+    // Taster-Flanke (nur mit EDGES ON): DOWN/UP mit Abtastzeit
+    if (event.type == IO_EVT_PRESS || event.type == IO_EVT_RELEASE) {
+        const bool down = (event.type == IO_EVT_PRESS);
+        if (SERIAL_PROTOCOL_ONLY) {
+            send_edge(down, event.id, event.us);
+        } else {
+            tx_drain(); // Reihenfolge zu gepufferten Antworten halten
+            Serial.printf(">>> %s %03u @%u us\n", down ? "DOWN" : "UP",
+                          event.id, event.us);
+        }
+        return;
+    }
+
+    if (event.type != IO_EVT_ACTIVE) {
+        return; // Nur Auswahl-Wechsel erzeugen PRESS/RELEASE
+    }
+
+    if (event.id > 0 && event.id <= BTN_COUNT) {
+        // Neuer Button aktiv -> PRESS senden
+        if (SERIAL_PROTOCOL_ONLY) {
+            send_press(event);
+        } else {
+            tx_drain();
+            Serial.printf(">>> PRESS %03u\n", event.id);
         }
+        _last_active_id = event.id;
+    } else if (_last_active_id > 0) {
+        // Kein Button mehr aktiv -> RELEASE senden
+        if (SERIAL_PROTOCOL_ONLY) {
+            send_release(_last_active_id, event.us);
+        } else {
+            tx_drain();
+            Serial.printf(">>> RELEASE %03u\n", _last_active_id);
+        }
+        _last_active_id = 0;
+    }
+}
+
+/**
+ * @brief Gibt einen vollen Zustands-Snapshot aus (nur Debug-Modus)
+ */
+static void print_snapshot(const log_event_t &event) {
+    tx_drain();
+    Serial.println("---");
+    print_byte_array("BTN RAW:    ", event.raw.data(), BTN_BYTES);
+    print_byte_array("BTN DEB:    ", event.deb.data(), BTN_BYTES);
+    Serial.printf("Active LED (One-Hot): %u\n", event.active_id);
+    print_byte_array("LED STATE:  ", event.led.data(), LED_BYTES);
+    print_pressed_list(event.deb);
+
+    if (LOG_VERBOSE_PER_ID) {
+        print_buttons_verbose(event.raw, event.deb);
+        print_leds_verbose(event.led);
     }
 }
 
+// =============================================================================
+// USB-CDC RX-CALLBACK
+// =============================================================================
+
+/**
+ * @brief Neue Bytes vom Pi: Serial-Task sofort wecken
+ * @note Laeuft im Event-Task des USB-Treibers, nicht im ISR-Kontext
+ */
+static void on_serial_rx(void *, esp_event_base_t, int32_t, void *) {
+    _rx_event_us.store(micros(), std::memory_order_relaxed);
+    notify_serial_task();
+}
+
 // =============================================================================
 // TASK-FUNKTION
 // =============================================================================
@@ -317,6 +1042,15 @@ static void read_serial_input() {
 static void serial_task_function(void *) {
     Serial.begin(SERIAL_BAUD);
     delay(100); // USB-CDC stabilisieren
+    start_tx_task(); // Ab hier sendet nur noch der TX-Task Protokollzeilen
+
+    if (SERIAL_RX_EVENTS) {
+#if ARDUINO_USB_MODE
+        Serial.onEvent(ARDUINO_HW_CDC_RX_EVENT, on_serial_rx);  // HWCDC
+#else
+        Serial.onEvent(ARDUINO_USB_CDC_RX_EVENT, on_serial_rx); // TinyUSB
+#endif
+    }
 
     if (SERIAL_PROTOCOL_ONLY) {
         // Protokoll-Modus: Nur READY und FW senden
@@ -334,62 +1068,39 @@ static void serial_task_function(void *) {
         Serial.println("========================================");
         Serial.printf("BTN_COUNT:       %u\n", BTN_COUNT);
         Serial.printf("LED_COUNT:       %u\n", LED_COUNT);
-        Serial.printf("IO_PERIOD_MS:    %u\n", IO_PERIOD_MS);
+        Serial.printf("IO_PERIOD_US:    %u (%s)\n", IO_PERIOD_US,
+                      IO_TIMER_SCAN ? "TIMER" : "TICK");
         Serial.printf("DEBOUNCE_MS:     %u\n", DEBOUNCE_MS);
+        Serial.printf("IO_PIPELINED:    %s\n", IO_PIPELINED ? "ON" : "OFF");
         Serial.printf("LATCH_SELECTION: %s\n",
                       LATCH_SELECTION ? "true" : "false");
         Serial.println("========================================");
         send_line("READY");
     }
 
-    log_event_t event = {};
+    io_event_t event = {};
+    log_event_t snapshot = {};
 
     for (;;) {
         // 1) Serial-Eingabe pruefen (Befehle vom Pi)
         read_serial_input();
+        command_check_timeout();
 
-        // 2) Queue mit Timeout lesen
-        if (xQueueReceive(_log_queue, &event, pdMS_TO_TICKS(10)) == pdTRUE) {
-
-            if (SERIAL_PROTOCOL_ONLY) {
-                // --- Protokoll-Modus: Nur PRESS/RELEASE senden ---
-                if (event.active_changed) {
-                    if (event.active_id > 0 && event.active_id <= BTN_COUNT) {
-                        // Neuer Button aktiv -> PRESS senden
-                        send_press(event.active_id);
-                        _last_active_id = event.active_id;
-                    } else if (_last_active_id > 0) {
-                        // Kein Button mehr aktiv -> RELEASE senden
-                        send_release(_last_active_id);
-                        _last_active_id = 0;
-                    }
-                }
-                continue;
-            }
-
-            // --- Debug-Modus: Ausfuehrliche Ausgabe ---
-            if (event.active_changed) {
-                if (event.active_id > 0) {
-                    Serial.printf(">>> PRESS %03u\n", event.active_id);
-                    _last_active_id = event.active_id;
-                } else if (_last_active_id > 0) {
-                    Serial.printf(">>> RELEASE %03u\n", _last_active_id);
-                    _last_active_id = 0;
-                }
-            }
-
-            Serial.println("---");
-            print_byte_array("BTN RAW:    ", event.raw, BTN_BYTES);
-            print_byte_array("BTN DEB:    ", event.deb, BTN_BYTES);
-            Serial.printf("Active LED (One-Hot): %u\n", event.active_id);
-            print_byte_array("LED STATE:  ", event.led, LED_BYTES);
-            print_pressed_list(event.deb);
+        // 2) Auf Events warten: Task-Notification vom IO-Task oder vom
+        //    RX-Callback. Timeout nur noch als Rueckfallebene bzw. als
+        //    Poll-Intervall ohne RX-Callback
+        if (_log->events.size() == 0 && _log->snapshots.size() == 0) {
+            ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(SERIAL_RX_POLL_MS));
+        }
 
-            if (LOG_VERBOSE_PER_ID) {
-                print_buttons_verbose(event.raw, event.deb);
-                print_leds_verbose(event.led);
-            }
+        // 3) Kompakte Events -> PRESS/RELEASE
+        while (_log->events.pop(event)) {
+            handle_event(event);
+        }
 
+        // 4) Debug-Modus: Volle Snapshots ausgeben
+        while (!SERIAL_PROTOCOL_ONLY && _log->snapshots.pop(snapshot)) {
+            print_snapshot(snapshot);
             vTaskDelay(1);
         }
     }
@@ -399,12 +1110,17 @@ static void serial_task_function(void *) {
 // OEFFENTLICHE FUNKTIONEN
 // =============================================================================
 
-void start_serial_task(QueueHandle_t log_queue) {
-    _log_queue = log_queue;
+void start_serial_task(log_channel_t *log) {
+    _log = log;
+    const command_hooks_t hooks = {send_line, execute_command,
+                                   commit_led_frame};
+    command_init(hooks); // vor der ersten Befehlszeile
     xTaskCreatePinnedToCore(serial_task_function, "Serial", 8192, nullptr,
-                            PRIO_SERIAL, nullptr, CORE_APP);
+                            PRIO_SERIAL, &_task, CORE_APP);
 }
 
-void set_led_callback(led_control_callback_t callback) {
-    _led_callback = callback;
+void notify_serial_task() {
+    if (_task != nullptr) {
+        xTaskNotifyGive(_task);
+    }
 }
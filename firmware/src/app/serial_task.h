@@ -3,14 +3,19 @@
  * @brief Serial Task fuer Pi-Kommunikation
  *
  * Verantwortung:
- * - Empfaengt Log-Events aus Queue -> sendet PRESS/RELEASE an Pi
- * - Empfaengt Befehle vom Pi -> steuert LEDs ueber Callback
+ * - Empfaengt Events aus dem Log-Kanal -> sendet PRESS/RELEASE an Pi
+ * - Empfaengt Befehle vom Pi -> command.cpp (LED-Callbacks, Batch)
  * - Einzige Stelle die Serial I/O macht
  *
  * Protokoll (1-basiert, 3-stellig):
  *   ESP32 -> Pi:  READY, FW, PRESS 001, RELEASE 001, PONG, OK, ERROR
+ *                 DOWN 001 <us>, UP 001 <us> (nur mit EDGES ON)
  *   Pi -> ESP32:  PING, STATUS, VERSION, HELP
  *                 LEDSET 001, LEDON 001, LEDOFF 001, LEDCLR, LEDALL
+ *                 LEDMASK <hex>
+ *                 DEBOUNCE EAGER|CONFIRM, EDGES ON|OFF
+ *                 #n <Befehl> (Tag: "#n OK"; LED-Befehle nach dem Latch)
+ *                 LEDCLR;LEDON 003;... bzw. BEGIN ... COMMIT (ein Frame)
  */
 #ifndef SERIAL_TASK_H
 #define SERIAL_TASK_H
@@ -19,44 +24,25 @@
 // INCLUDES
 // =============================================================================
 
+#include "app/command.h"
+#include "types.h"
 #include "freertos/FreeRTOS.h"
-#include "freertos/queue.h"
 #include <Arduino.h>
 
-// =============================================================================
-// TYPES
-// =============================================================================
-
-/**
- * @brief LED-Befehle vom Pi
- */
-typedef enum led_command {
-    LED_CMD_SET,    /**< One-hot: nur diese LED an */
-    LED_CMD_ON,     /**< Additiv: LED einschalten */
-    LED_CMD_OFF,    /**< Additiv: LED ausschalten */
-    LED_CMD_CLEAR,  /**< Alle LEDs aus */
-    LED_CMD_ALL     /**< Alle LEDs an */
-} led_command_e;
-
-/**
- * @brief Callback-Typ fuer LED-Steuerung (implementiert in io_task)
- */
-typedef void (*led_control_callback_t)(led_command_e cmd, uint8_t id);
-
 // =============================================================================
 // OEFFENTLICHE FUNKTIONEN
 // =============================================================================
 
 /**
  * @brief Startet den Serial-Task auf CORE_APP mit PRIO_SERIAL
- * @param log_queue Queue fuer Log-Events
+ * @param log Log-Kanal (Serial-Task ist einziger Consumer)
  */
-void start_serial_task(QueueHandle_t log_queue);
+void start_serial_task(log_channel_t *log);
 
 /**
- * @brief Registriert Callback fuer LED-Befehle vom Pi
- * @param callback Callback-Funktion
+ * @brief Weckt den Serial-Task (nach push() in den Log-Kanal)
+ * @note Nur aus Task-Kontext aufrufen
  */
-void set_led_callback(led_control_callback_t callback);
+void notify_serial_task();
 
 #endif // SERIAL_TASK_H
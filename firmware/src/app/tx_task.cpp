@@ -0,0 +1,231 @@
+/**
+ * @file tx_task.cpp
+ * @brief USB-TX-Task Implementation (Stream-Buffer → CdcLineWriter)
+ */
+
+// =============================================================================
+// INCLUDES
+// =============================================================================
+
+#include "app/tx_task.h"
+#include "hal/cdc_writer.h"
+
+#include "config.h"
+#include <Arduino.h>
+#include <atomic>
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/stream_buffer.h"
+#include "freertos/task.h"
+
+// =============================================================================
+// MODUL-LOKALE VARIABLEN
+// =============================================================================
+
+static StreamBufferHandle_t _stream = nullptr;
+
+// Nur vom TX-Task benutzt
+static CdcLineWriter _writer;
+static uint8_t _stage[2 * (CDC_PACKET_SIZE + 1)]; // Datensaetze [len][bytes]
+static size_t _stage_len = 0;
+
+// Sender-Seite (nur Serial-Task schreibt)
+static uint32_t _queued_bytes = 0;
+static uint32_t _high_water = 0;
+static uint32_t _stalls = 0;
+static uint32_t _drops = 0;
+
+// Vom TX-Task gesendete Bytes (fuer tx_drain)
+static std::atomic<uint32_t> _sent_bytes{0};
+
+// =============================================================================
+// PRIVATE FUNKTIONEN
+// =============================================================================
+
+/**
+ * @brief Wartet auf Platz im Stream-Buffer (max. SERIAL_TX_STALL_MS)
+ * @param bytes Benoetigte Bytes inkl. Laengen-Bytes der Datensaetze
+ * @return false wenn verworfen (zaehlt als Drop)
+ */
+static bool wait_for_space(size_t bytes) {
+    if (xStreamBufferSpacesAvailable(_stream) >= bytes) {
+        return true;
+    }
+    _stalls++;
+    uint32_t waited_ms = 0;
+    while (xStreamBufferSpacesAvailable(_stream) < bytes) {
+        if (waited_ms >= SERIAL_TX_STALL_MS) {
+            _drops++;
+            return false;
+        }
+        vTaskDelay(1);
+        waited_ms += portTICK_PERIOD_MS;
+    }
+    return true;
+}
+
+/**
+ * @brief Legt einen Datensatz [len][bytes] ab (Platz vorher geprueft)
+ */
+static void push_record(const uint8_t *data, size_t len) {
+    uint8_t record[1 + CDC_PACKET_SIZE];
+    record[0] = (uint8_t)len;
+    memcpy(record + 1, data, len);
+
+    xStreamBufferSend(_stream, record, len + 1, 0);
+    _queued_bytes += len + 1;
+
+    const uint32_t depth = xStreamBufferBytesAvailable(_stream);
+    if (depth > _high_water) {
+        _high_water = depth;
+    }
+}
+
+/**
+ * @brief Alter Sendepfad: ein Datensatz pro USB-Paket
+ * @note Blockiert > 2 ms pro Datensatz (SERIAL_TX_COALESCE=false, tx_bench)
+ */
+static void write_legacy(const uint8_t *data, size_t len) {
+    Serial.write(data, len);
+    Serial.flush();
+    delayMicroseconds(2000); // 2ms USB-CDC Paket abschliessen lassen
+}
+
+/**
+ * @brief Gibt alle vollstaendigen Datensaetze aus _stage an den Writer
+ * @return Anzahl verbrauchter Bytes
+ */
+static size_t emit_stage_records() {
+    size_t start = 0;
+
+    // Datensatz: [len][len Bytes] (Zeile inkl. '\n' oder COBS-Frame)
+    while (start < _stage_len && start + 1 + _stage[start] <= _stage_len) {
+        const uint8_t len = _stage[start];
+        if (SERIAL_TX_COALESCE) {
+            _writer.write(_stage + start + 1, len);
+        } else {
+            write_legacy(_stage + start + 1, len);
+        }
+        start += 1 + len;
+    }
+
+    // Rest (angefangener Datensatz) an den Anfang schieben
+    memmove(_stage, _stage + start, _stage_len - start);
+    _stage_len -= start;
+    return start;
+}
+
+/**
+ * @brief Hauptschleife des TX-Tasks
+ */
+static void tx_task_function(void *) {
+    uint32_t consumed = 0;
+
+    for (;;) {
+        // Mit angefangenem Paket nur SERIAL_TX_IDLE_MS warten
+        const TickType_t wait = _writer.pending()
+                                    ? pdMS_TO_TICKS(SERIAL_TX_IDLE_MS)
+                                    : portMAX_DELAY;
+        const size_t n = xStreamBufferReceive(
+            _stream, _stage + _stage_len, sizeof(_stage) - _stage_len, wait);
+
+        if (n > 0) {
+            _stage_len += n;
+            consumed += emit_stage_records();
+
+            if (!xStreamBufferIsEmpty(_stream)) {
+                continue; // Burst laeuft noch, weiter sammeln
+            }
+            if (SERIAL_TX_IDLE_MS > 0 && _writer.pending()) {
+                continue; // Leerlauf-Timeout im naechsten Receive
+            }
+        }
+
+        // Leerlauf: angefangenes Paket senden
+        _writer.flush();
+        _sent_bytes.store(consumed, std::memory_order_release);
+    }
+}
+
+// =============================================================================
+// OEFFENTLICHE FUNKTIONEN
+// =============================================================================
+
+void start_tx_task() {
+    _stream = xStreamBufferCreate(SERIAL_TX_BUF_LEN, 1);
+    xTaskCreatePinnedToCore(tx_task_function, "SerialTx", 4096, nullptr,
+                            PRIO_TX, nullptr, CORE_APP);
+}
+
+bool tx_send_line(const char *line) {
+    // Lange Zeilen in mehreren Datensaetzen, '\n' nur im letzten. Platz
+    // fuer alle vorab: nie eine halbe Zeile im Buffer
+    size_t len = strlen(line);
+    const size_t records = len / CDC_PACKET_SIZE + 1;
+    if (!wait_for_space(len + 1 + records)) {
+        return false;
+    }
+
+    const uint8_t *text = reinterpret_cast<const uint8_t *>(line);
+    while (len >= CDC_PACKET_SIZE) {
+        push_record(text, CDC_PACKET_SIZE);
+        text += CDC_PACKET_SIZE;
+        len -= CDC_PACKET_SIZE;
+    }
+    uint8_t buf[CDC_PACKET_SIZE];
+    memcpy(buf, text, len);
+    buf[len] = '\n';
+    push_record(buf, len + 1);
+    return true;
+}
+
+bool tx_send(const uint8_t *data, size_t len) {
+    if (len == 0 || len > CDC_PACKET_SIZE) {
+        _drops++;
+        return false;
+    }
+    if (!wait_for_space(len + 1)) {
+        return false;
+    }
+    push_record(data, len);
+    return true;
+}
+
+void tx_drain() {
+    while (_sent_bytes.load(std::memory_order_acquire) != _queued_bytes) {
+        vTaskDelay(1);
+    }
+}
+
+void tx_get_stats(tx_stats_t *out) {
+    out->depth = xStreamBufferBytesAvailable(_stream);
+    out->high_water = _high_water;
+    out->capacity = SERIAL_TX_BUF_LEN;
+    out->stalls = _stalls;
+    out->drops = _drops;
+    out->packets = _writer.packets();
+}
+
+void tx_bench(uint16_t n, tx_bench_result_t *out) {
+    char line[16];
+    CdcLineWriter writer;
+
+    tx_drain(); // TX-Task ist leer, Serial gehoert jetzt dem Aufrufer
+
+    uint32_t start_us = micros();
+    for (uint16_t i = 0; i < n; i++) {
+        const int len = snprintf(line, sizeof(line), "BENCH L%04u\n", i);
+        write_legacy(reinterpret_cast<const uint8_t *>(line), (size_t)len);
+    }
+    out->legacy_us = micros() - start_us;
+
+    start_us = micros();
+    for (uint16_t i = 0; i < n; i++) {
+        snprintf(line, sizeof(line), "BENCH C%04u", i);
+        writer.writeLine(line);
+    }
+    writer.flush();
+    out->coalesce_us = micros() - start_us;
+    out->packets = writer.packets();
+}
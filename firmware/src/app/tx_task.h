@@ -0,0 +1,101 @@
+/**
+ * @file tx_task.h
+ * @brief USB-TX-Task: entkoppelt Protokoll-Ausgabe vom USB-Stack
+ *
+ * Warum ein eigener Task?
+ * - Serial.flush() blockiert, bis der Host das Paket abgeholt hat
+ * - Im Serial-Task wuerde ein OK auf LEDSET hinter PRESS/STATUS warten
+ *   und Befehle wuerden in dieser Zeit nicht gelesen
+ *
+ * Ablauf:
+ * - Serial-Task legt ganze Zeilen bzw. Binaer-Frames als Datensatz
+ *   [len][bytes] in einen Stream-Buffer (nicht blockierend)
+ * - TX-Task (PRIO_TX, unter PRIO_SERIAL) holt sie ab, packt sie per
+ *   CdcLineWriter in 64-Byte-Pakete und sendet im Leerlauf
+ *
+ * Stream-Buffer: genau ein Sender (Serial-Task), ein Empfaenger (TX-Task).
+ */
+#ifndef TX_TASK_H
+#define TX_TASK_H
+
+// =============================================================================
+// INCLUDES
+// =============================================================================
+
+#include <stddef.h>
+#include <stdint.h>
+
+// =============================================================================
+// TYPES
+// =============================================================================
+
+/**
+ * @brief Zustand der TX-Richtung (fuer STATUS/TXQ)
+ */
+typedef struct tx_stats {
+    uint32_t depth;      /**< Bytes aktuell im Stream-Buffer */
+    uint32_t high_water; /**< Max. Fuellstand seit Start (Bytes) */
+    uint32_t capacity;   /**< Groesse des Stream-Buffers (Bytes) */
+    uint32_t stalls;     /**< Sender musste auf Platz warten */
+    uint32_t drops;      /**< Zeilen verworfen (kein Platz nach Wartezeit) */
+    uint32_t packets;    /**< Gesendete USB-Pakete */
+} tx_stats_t;
+
+/**
+ * @brief Ergebnis von tx_bench()
+ */
+typedef struct tx_bench_result {
+    uint32_t legacy_us;   /**< Blockierzeit alter Pfad (flush + 2 ms/Zeile) */
+    uint32_t coalesce_us; /**< Blockierzeit CdcLineWriter */
+    uint32_t packets;     /**< Pakete im CdcLineWriter-Durchlauf */
+} tx_bench_result_t;
+
+// =============================================================================
+// OEFFENTLICHE FUNKTIONEN
+// =============================================================================
+
+/**
+ * @brief Erstellt den Stream-Buffer und startet den TX-Task
+ * @note Nach Serial.begin() aufrufen (aus dem Serial-Task)
+ */
+void start_tx_task();
+
+/**
+ * @brief Legt eine Zeile zum Senden ab ('\n' wird ergaenzt)
+ * @param line Nullterminierte Zeile (laenger als CDC_PACKET_SIZE: mehrere
+ *             Datensaetze, nie gekuerzt)
+ * @return false wenn verworfen (Buffer nach SERIAL_TX_STALL_MS noch voll)
+ * @note Nur aus dem Serial-Task aufrufen (einziger Sender)
+ */
+bool tx_send_line(const char *line);
+
+/**
+ * @brief Legt einen Datensatz (z.B. Binaer-Frame) unveraendert ab
+ * @param data Bytes
+ * @param len Laenge (1..CDC_PACKET_SIZE)
+ * @return false wenn verworfen (ungueltige Laenge oder Buffer voll)
+ * @note Nur aus dem Serial-Task aufrufen (einziger Sender)
+ */
+bool tx_send(const uint8_t *data, size_t len);
+
+/**
+ * @brief Wartet, bis alle abgelegten Zeilen gesendet sind
+ * @note Vor direkten Serial-Ausgaben (Debug-Modus, Benchmark)
+ */
+void tx_drain();
+
+/**
+ * @brief Liest die TX-Statistik
+ * @param out Ziel
+ */
+void tx_get_stats(tx_stats_t *out);
+
+/**
+ * @brief TX-Benchmark: n Zeilen ueber alten Pfad und CdcLineWriter
+ * @param n Anzahl Zeilen je Pfad
+ * @param out Blockierzeiten und Paketanzahl
+ * @note Laeuft im Aufrufer (Serial-Task) nach tx_drain(), TX-Task ist leer
+ */
+void tx_bench(uint16_t n, tx_bench_result_t *out);
+
+#endif // TX_TASK_H
@@ -8,6 +8,7 @@
 // =============================================================================
 
 #include "drivers/cd4021.h"
+#include "hal/fast_gpio.h"
 
 // =============================================================================
 // OEFFENTLICHE FUNKTIONEN
@@ -23,37 +24,52 @@ void Cd4021::init() {
     pinMode(PIN_BTN_MISO, INPUT_PULLUP);
 }
 
-void Cd4021::readRaw(SpiBus &bus, uint8_t *out) {
+void Cd4021::parallelLoad() {
     // -------------------------------------------------------------------------
     // Schritt 1: Parallel Load
     // -------------------------------------------------------------------------
     // P/S = HIGH: Taster-Zustaende werden ins Register "fotografiert"
-    digitalWrite(PIN_BTN_PS, HIGH);
-    delayMicroseconds(5); // Hold-Zeit fuer stabiles Einlesen
+    if (GPIO_FAST_PATH) {
+        fast_gpio_high(PIN_BTN_PS);
+        fast_delay_ns(BTN_PS_PULSE_NS); // Mindest-Pulsbreite
+    } else {
+        digitalWrite(PIN_BTN_PS, HIGH);
+        delayMicroseconds(5); // Hold-Zeit fuer stabiles Einlesen
+    }
 
     // -------------------------------------------------------------------------
     // Schritt 2: Umschalten auf Shift-Mode
     // -------------------------------------------------------------------------
-    digitalWrite(PIN_BTN_PS, LOW);
-    delayMicroseconds(1); // Stabilisierungszeit
+    if (GPIO_FAST_PATH) {
+        fast_gpio_low(PIN_BTN_PS);
+        fast_delay_ns(BTN_PS_SETTLE_NS); // Removal-Zeit vor erstem Clock
+    } else {
+        digitalWrite(PIN_BTN_PS, LOW);
+        delayMicroseconds(1); // Stabilisierungszeit
+    }
+}
+
+void Cd4021::readRaw(SpiBus &bus, btn_bits_t &out) {
+    // Schritt 1+2: Parallel Load, dann Shift-Mode
+    parallelLoad();
 
     // -------------------------------------------------------------------------
     // Schritt 3: KRITISCH - Erstes Bit vor SPI sichern
     // -------------------------------------------------------------------------
     // Q8 liegt jetzt bereits am Ausgang an (noch vor dem ersten Clock!)
     // Wenn wir das nicht separat lesen, verlieren wir Taster 1.
-    const uint8_t first_bit = digitalRead(PIN_BTN_MISO) ? 1u : 0u;
+    const bool q8 = GPIO_FAST_PATH ? fast_gpio_read(PIN_BTN_MISO)
+                                   : (digitalRead(PIN_BTN_MISO) != 0);
+    const uint8_t first_bit = q8 ? 1u : 0u;
 
     // -------------------------------------------------------------------------
     // Schritt 4: Restliche Bits per SPI einlesen
     // -------------------------------------------------------------------------
+    // Ein Transfer fuer die ganze Kette (0x00 senden)
     uint8_t rx[BTN_BYTES] = {0};
 
-    {
-        SpiGuard guard(bus, _spi);
-        for (size_t i = 0; i < BTN_BYTES; ++i) {
-            rx[i] = SPI.transfer(0x00);
-        }
+    if (!bus.transfer(SPI_DEV_BTN, nullptr, rx, BTN_BYTES)) {
+        return; // Bus-Fehler: letzten Zustand behalten
     }
 
     // -------------------------------------------------------------------------
@@ -65,9 +81,14 @@ void Cd4021::readRaw(SpiBus &bus, uint8_t *out) {
     // out[0]: [first_bit | rx[0] bits 7-1]
     // out[1]: [rx[0] bit 0 | rx[1] bits 7-1]
 
-    out[0] = static_cast<uint8_t>((first_bit << 7) | (rx[0] >> 1));
+    uint8_t *bytes = out.data();
+    bytes[0] = static_cast<uint8_t>((first_bit << 7) | (rx[0] >> 1));
 
     for (size_t i = 1; i < BTN_BYTES; ++i) {
-        out[i] = static_cast<uint8_t>(((rx[i - 1] & 0x01) << 7) | (rx[i] >> 1));
+        bytes[i] =
+            static_cast<uint8_t>(((rx[i - 1] & 0x01) << 7) | (rx[i] >> 1));
     }
+
+    // Unbelegte Eingaenge im letzten Byte auf 0 (BitSet-Invariante)
+    out.mask_unused();
 }
@@ -7,7 +7,7 @@
  * Besonderheit "First-Bit-Problem":
  * Nach Parallel-Load liegt Q8 sofort an, BEVOR der erste Clock kommt.
  * SPI samplet aber erst NACH der ersten Flanke -> Bit 1 geht verloren.
- * Loesung: Erstes Bit vor SPI per digitalRead() sichern.
+ * Loesung: Erstes Bit vor SPI per GPIO-Registerzugriff sichern.
  */
 #ifndef CD4021_H
 #define CD4021_H
@@ -16,6 +16,7 @@
 // INCLUDES
 // =============================================================================
 
+#include "bitops.h"
 #include "config.h"
 #include "hal/spi_bus.h"
 #include <Arduino.h>
@@ -37,12 +38,15 @@ public:
     /**
      * @brief Liest alle Taster (mit First-Bit-Korrektur)
      * @param bus SPI-Bus Instanz
-     * @param out Ausgabe-Array [BTN_BYTES]
+     * @param out Taster-Zustand (unbelegte Eingaenge werden maskiert)
      */
-    void readRaw(SpiBus& bus, uint8_t* out);
+    void readRaw(SpiBus& bus, btn_bits_t& out);
 
-private:
-    SPISettings _spi{SPI_HZ_BTN, MSBFIRST, SPI_MODE_BTN};  /**< SPI-Einstellungen */
+    /**
+     * @brief Parallel-Load: Taster-Zustaende ins Register uebernehmen
+     * @note Danach steht Taster 1 an Q8, die Kette ist im Shift-Mode
+     */
+    void parallelLoad();
 };
 
 #endif // CD4021_H
@@ -0,0 +1,68 @@
+/**
+ * @file duplex_scan.cpp
+ * @brief DuplexScan Implementation
+ */
+
+// =============================================================================
+// INCLUDES
+// =============================================================================
+
+#include "drivers/duplex_scan.h"
+
+// =============================================================================
+// OEFFENTLICHE FUNKTIONEN
+// =============================================================================
+
+void DuplexScan::transfer(SpiBus &bus, Cd4021 &buttons, Hc595 &leds,
+                          led_bits_t &led_state, btn_bits_t &btn_out) {
+    if (start(bus, buttons, led_state)) {
+        finish(bus, leds, btn_out);
+    }
+}
+
+bool DuplexScan::start(SpiBus &bus, Cd4021 &buttons, led_bits_t &led_state) {
+    // -------------------------------------------------------------------------
+    // Schritt 1: TX-Frame aufbauen
+    // -------------------------------------------------------------------------
+    // Daisy-Chain: Letztes LED-Byte zuerst. Bei laengerer Taster-Kette
+    // stehen vorne Fuellbytes, die am Ende der 74HC595-Kette herausfallen.
+    led_state.mask_unused();
+    const uint8_t *led = led_state.data();
+
+    uint8_t tx[SCAN_BYTES];
+    for (size_t k = 0; k < SCAN_BYTES; ++k) {
+        const size_t idx = SCAN_BYTES - 1 - k;
+        tx[k] = (idx < LED_BYTES) ? led[idx] : 0x00;
+    }
+
+    // -------------------------------------------------------------------------
+    // Schritt 2: Parallel Load der Taster
+    // -------------------------------------------------------------------------
+    buttons.parallelLoad();
+
+    // -------------------------------------------------------------------------
+    // Schritt 3: Ein Transfer fuer beide Ketten (laeuft ggf. per DMA)
+    // -------------------------------------------------------------------------
+    // MODE0: MISO wird bei steigender Flanke gesampelt, bevor der CD4021B
+    // weiterschiebt -> rx[0] Bit7 = Taster 1 (keine First-Bit-Korrektur)
+    return bus.startTransfer(SPI_DEV_SCAN, tx, SCAN_BYTES);
+}
+
+bool DuplexScan::finish(SpiBus &bus, Hc595 &leds, btn_bits_t &btn_out) {
+    uint8_t rx[SCAN_BYTES];
+    if (!bus.finishTransfer(rx, SCAN_BYTES)) {
+        return false; // Bus-Fehler: nicht latchen, Taster unveraendert
+    }
+
+    // -------------------------------------------------------------------------
+    // Schritt 4: LEDs uebernehmen
+    // -------------------------------------------------------------------------
+    leds.latch();
+
+    // -------------------------------------------------------------------------
+    // Schritt 5: Taster-Bits uebernehmen
+    // -------------------------------------------------------------------------
+    memcpy(btn_out.data(), rx, BTN_BYTES);
+    btn_out.mask_unused();
+    return true;
+}
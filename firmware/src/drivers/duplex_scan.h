@@ -0,0 +1,74 @@
+/**
+ * @file duplex_scan.h
+ * @brief Full-Duplex Scan: CD4021B lesen + 74HC595 schreiben in einem Transfer
+ *
+ * Beide Ketten haengen am selben SCK. Statt zwei Transaktionen (Taster mit
+ * 0x00 lesen, dann LEDs schreiben) laeuft pro Zyklus EIN Transfer:
+ * - MOSI: LED-Frame (letztes Byte zuerst) -> 74HC595-Kette
+ * - MISO: Taster-Bits 1..N               <- CD4021B-Kette
+ * - danach ein Latch (RCK)
+ *
+ * Vorteile:
+ * - Halbe Buszeit pro Zyklus (ein Takt-Durchlauf statt zwei)
+ * - Es werden nie Nullen in die 74HC595 geschoben (kein Zero-Shift)
+ * - LED-Refresh jeden Zyklus ohne Zusatzkosten
+ *
+ * Ketten unterschiedlicher Laenge: Frame = SCAN_BYTES (laengere Kette).
+ * Fuehrende Fuellbytes fallen hinten aus der 74HC595-Kette heraus,
+ * ueberzaehlige MISO-Bytes werden ignoriert.
+ */
+#ifndef DUPLEX_SCAN_H
+#define DUPLEX_SCAN_H
+
+// =============================================================================
+// INCLUDES
+// =============================================================================
+
+#include "bitops.h"
+#include "config.h"
+#include "drivers/cd4021.h"
+#include "drivers/hc595.h"
+#include "hal/spi_bus.h"
+#include <Arduino.h>
+
+// =============================================================================
+// CLASSES
+// =============================================================================
+
+/**
+ * @brief Kombinierter Taster-/LED-Transfer auf dem gemeinsamen SPI-Bus
+ */
+class DuplexScan {
+public:
+    /**
+     * @brief Liest alle Taster und schreibt gleichzeitig alle LEDs
+     * @param bus SPI-Bus Instanz
+     * @param buttons CD4021B-Treiber (Parallel-Load)
+     * @param leds 74HC595-Treiber (Latch)
+     * @param led_state LED-Zustand (unbenutzte Bits werden auf 0 gesetzt)
+     * @param btn_out Taster-Zustand (unbelegte Eingaenge werden maskiert)
+     */
+    void transfer(SpiBus& bus, Cd4021& buttons, Hc595& leds,
+                  led_bits_t& led_state, btn_bits_t& btn_out);
+
+    /**
+     * @brief Erste Haelfte: Parallel-Load und Transfer starten
+     * @param bus SPI-Bus Instanz
+     * @param buttons CD4021B-Treiber (Parallel-Load)
+     * @param led_state LED-Zustand (wird kopiert, darf danach geaendert werden)
+     * @return true wenn gestartet (dann finish() Pflicht)
+     * @note Mit SPI_BACKEND_DMA laeuft der Transfer im Hintergrund weiter
+     */
+    bool start(SpiBus& bus, Cd4021& buttons, led_bits_t& led_state);
+
+    /**
+     * @brief Zweite Haelfte: Auf Transfer warten, latchen, Taster uebernehmen
+     * @param bus SPI-Bus Instanz
+     * @param leds 74HC595-Treiber (Latch)
+     * @param btn_out Taster-Zustand (unbelegte Eingaenge werden maskiert)
+     * @return true bei Erfolg
+     */
+    bool finish(SpiBus& bus, Hc595& leds, btn_bits_t& btn_out);
+};
+
+#endif // DUPLEX_SCAN_H
@@ -8,6 +8,7 @@
 // =============================================================================
 
 #include "drivers/hc595.h"
+#include "hal/fast_gpio.h"
 
 // =============================================================================
 // OEFFENTLICHE FUNKTIONEN
@@ -44,42 +45,35 @@ void Hc595::setBrightness(uint8_t percent) {
     ledcWrite(LEDC_CHANNEL, duty);
 }
 
-void Hc595::write(SpiBus &bus, uint8_t *state) {
-    maskUnused(state);
-
-    {
-        SpiGuard guard(bus, _spi);
+void Hc595::write(SpiBus &bus, led_bits_t &state) {
+    // Bei 10 LEDs: Byte 1 nutzt nur Bit 0-1 (LED 9-10)
+    // Bits 2-7 auf 0 setzen, sonst koennten "Ghost-LEDs" leuchten
+    state.mask_unused();
+    const uint8_t *bytes = state.data();
 
-        // Daisy-Chain: Letztes Byte zuerst senden
-        // Es "rutscht durch" alle ICs und landet im letzten (IC1 = LED 9-10)
-        // Das zuletzt gesendete Byte bleibt im ersten IC (IC0 = LED 1-8)
-        for (int i = LED_BYTES - 1; i >= 0; --i) {
-            SPI.transfer(state[i]);
-        }
+    // Daisy-Chain: Letztes Byte zuerst senden
+    // Es "rutscht durch" alle ICs und landet im letzten (IC1 = LED 9-10)
+    // Das zuletzt gesendete Byte bleibt im ersten IC (IC0 = LED 1-8)
+    uint8_t tx[LED_BYTES];
+    for (size_t k = 0; k < LED_BYTES; ++k) {
+        tx[k] = bytes[LED_BYTES - 1 - k];
     }
 
-    latch();
-}
-
-// =============================================================================
-// PRIVATE METHODEN
-// =============================================================================
-
-void Hc595::maskUnused(uint8_t *state) {
-    // Bei 10 LEDs: Byte 1 nutzt nur Bit 0-1 (LED 9-10)
-    // Bits 2-7 auf 0 setzen, sonst koennten "Ghost-LEDs" leuchten
-    if (LED_COUNT % 8 == 0) {
-        return;
+    if (!bus.transfer(SPI_DEV_LED, tx, nullptr, LED_BYTES)) {
+        return; // Bus-Fehler: nicht latchen, alte Ausgaenge bleiben
     }
 
-    const uint8_t used_bits = LED_COUNT % 8;
-    const uint8_t mask = static_cast<uint8_t>((1u << used_bits) - 1);
-    state[LED_BYTES - 1] &= mask;
+    latch();
 }
 
 void Hc595::latch() {
     // Steigende Flanke an RCK uebernimmt Schieberegister -> Ausgaenge
     // Alle ICs in der Kette latchen synchron
+    if (GPIO_FAST_PATH) {
+        fast_gpio_pulse_high(PIN_LED_RCK, LED_RCK_PULSE_NS);
+        return;
+    }
+
     digitalWrite(PIN_LED_RCK, HIGH);
     delayMicroseconds(1); // Setup-Zeit (Datenblatt: 20 ns)
     digitalWrite(PIN_LED_RCK, LOW);
@@ -6,7 +6,7 @@
  *
  * Besonderheiten:
  * - Daisy-Chain: Letztes Byte zuerst senden (rutscht durch die Kette)
- * - Ghost-Maskierung: Unbenutzte Bits auf 0 setzen
+ * - Ghost-Maskierung: Unbenutzte Bits auf 0 setzen (led_bits_t::mask_unused)
  * - PWM ueber OE: Globale Helligkeitsregelung
  */
 #ifndef HC595_H
@@ -16,6 +16,7 @@
 // INCLUDES
 // =============================================================================
 
+#include "bitops.h"
 #include "config.h"
 #include "hal/spi_bus.h"
 #include <Arduino.h>
@@ -43,23 +44,15 @@ public:
     /**
      * @brief Schreibt LED-Zustand ueber SPI und latcht
      * @param bus SPI-Bus Instanz
-     * @param state LED-Zustand [LED_BYTES]
+     * @param state LED-Zustand (unbenutzte Bits werden auf 0 gesetzt)
      */
-    void write(SpiBus& bus, uint8_t* state);
-
-private:
-    /**
-     * @brief Setzt unbenutzte Bits auf 0 (Ghost-LEDs verhindern)
-     * @param state LED-Zustand Array
-     */
-    void maskUnused(uint8_t* state);
+    void write(SpiBus& bus, led_bits_t& state);
 
     /**
      * @brief Latch-Impuls: Uebernimmt Schieberegister -> Ausgaenge
+     * @note Oeffentlich fuer DuplexScan (Latch nach kombiniertem Transfer)
      */
     void latch();
-
-    SPISettings _spi{SPI_HZ_LED, MSBFIRST, SPI_MODE_LED};  /**< SPI-Einstellungen */
 };
 
 #endif // HC595_H
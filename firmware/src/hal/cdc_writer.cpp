@@ -0,0 +1,73 @@
+/**
+ * @file cdc_writer.cpp
+ * @brief CdcLineWriter Implementation
+ */
+
+// =============================================================================
+// INCLUDES
+// =============================================================================
+
+#include "hal/cdc_writer.h"
+#include <Arduino.h>
+#include <string.h>
+
+// =============================================================================
+// OEFFENTLICHE FUNKTIONEN
+// =============================================================================
+
+void CdcLineWriter::writeLine(const char *line) {
+    const size_t len = strlen(line);
+
+    // Ueberlange Zeile (Debug-Ausgabe): Paketgrenze egal, direkt senden
+    if (len + 1 > CDC_PACKET_SIZE) {
+        flush();
+        Serial.write(reinterpret_cast<const uint8_t *>(line), len);
+        Serial.write('\n');
+        Serial.flush();
+        _lines++;
+        return;
+    }
+
+    uint8_t buf[CDC_PACKET_SIZE];
+    memcpy(buf, line, len);
+    buf[len] = '\n';
+    write(buf, len + 1);
+}
+
+void CdcLineWriter::write(const uint8_t *data, size_t len) {
+    // Ueberlanger Datensatz: Paketgrenze egal, direkt senden
+    if (len > CDC_PACKET_SIZE) {
+        flush();
+        Serial.write(data, len);
+        Serial.flush();
+        _lines++;
+        return;
+    }
+
+    // Passt nicht mehr → erst das volle Paket abschicken
+    if (_len + len > CDC_PACKET_SIZE) {
+        flush();
+    }
+
+    memcpy(_buf + _len, data, len);
+    _len += len;
+    _lines++;
+
+    // Paket exakt voll → sofort senden
+    if (_len == CDC_PACKET_SIZE) {
+        flush();
+    }
+}
+
+void CdcLineWriter::flush() {
+    if (_len == 0) {
+        return;
+    }
+
+    // Ein write() pro Paket; flush() wartet, bis der TX-Puffer leer ist,
+    // damit das naechste Paket wieder an einer Paketgrenze beginnt
+    Serial.write(_buf, _len);
+    Serial.flush();
+    _len = 0;
+    _packets++;
+}
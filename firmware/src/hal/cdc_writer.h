@@ -0,0 +1,89 @@
+/**
+ * @file cdc_writer.h
+ * @brief Zeilen-Sammler fuer USB-CDC: ganze Zeilen in 64-Byte-Paketen
+ *
+ * Warum nicht Serial.print() + flush() + 2 ms Delay pro Zeile?
+ * - Jede Zeile belegt ein eigenes USB-Paket und ca. 2 ms CPU-Zeit
+ * - STATUS (11 Zeilen) blockiert den Serial-Task > 12 ms
+ * - Burst von PRESS/RELEASE ist auf ca. 500 Zeilen/s begrenzt
+ *
+ * Hier:
+ * - Zeilen werden in einem Paketpuffer (CDC_PACKET_SIZE) gesammelt
+ * - Passt eine Zeile nicht mehr hinein, wird zuerst das Paket gesendet
+ *   → eine Zeile wird nie auf zwei Pakete verteilt (keine Fragmente)
+ * - Gesendet wird bei vollem Paket oder per flush() im Leerlauf
+ * - Ein flush() pro Paket statt pro Zeile, kein Sleep
+ *
+ * Gleiches gilt fuer binaere Frames (write()): ein Datensatz liegt immer
+ * vollstaendig in einem Paket.
+ *
+ * Nur aus einem Task verwenden (TX-Task), nicht thread-safe.
+ */
+#ifndef CDC_WRITER_H
+#define CDC_WRITER_H
+
+// =============================================================================
+// INCLUDES
+// =============================================================================
+
+#include <stddef.h>
+#include <stdint.h>
+
+// =============================================================================
+// KONSTANTEN
+// =============================================================================
+
+// Full-Speed USB Bulk-Endpoint: max. 64 Bytes pro Paket
+constexpr size_t CDC_PACKET_SIZE = 64;
+
+// =============================================================================
+// CLASSES
+// =============================================================================
+
+/**
+ * @brief Sammelt ganze Zeilen/Frames und sendet sie paketweise
+ */
+class CdcLineWriter {
+public:
+    /**
+     * @brief Haengt eine Zeile an (ohne '\n', wird ergaenzt)
+     * @param line Nullterminierte Zeile
+     * @note Zeilen >= CDC_PACKET_SIZE werden direkt gesendet (nur Debug)
+     */
+    void writeLine(const char *line);
+
+    /**
+     * @brief Haengt einen Datensatz an (Zeile inkl. '\n' oder Frame)
+     * @param data Bytes
+     * @param len Laenge (> CDC_PACKET_SIZE: direkt gesendet, nur Debug)
+     */
+    void write(const uint8_t *data, size_t len);
+
+    /**
+     * @brief Sendet das angefangene Paket (Leerlauf)
+     */
+    void flush();
+
+    /**
+     * @brief true wenn ungesendete Bytes im Paketpuffer liegen
+     */
+    bool pending() const { return _len > 0; }
+
+    /**
+     * @brief Gesendete Pakete seit Start
+     */
+    uint32_t packets() const { return _packets; }
+
+    /**
+     * @brief Gesendete Datensaetze (Zeilen/Frames) seit Start
+     */
+    uint32_t lines() const { return _lines; }
+
+private:
+    uint8_t _buf[CDC_PACKET_SIZE]; /**< Paketpuffer */
+    size_t _len = 0;               /**< Belegte Bytes */
+    uint32_t _packets = 0;         /**< Statistik: Pakete */
+    uint32_t _lines = 0;           /**< Statistik: Datensaetze */
+};
+
+#endif // CDC_WRITER_H
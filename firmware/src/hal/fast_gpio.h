@@ -0,0 +1,109 @@
+/**
+ * @file fast_gpio.h
+ * @brief Direkter GPIO-Registerzugriff und zyklengenaue Mindestpulse
+ *
+ * Warum nicht digitalWrite()?
+ * - digitalWrite()/digitalRead() prueft Pin-Nummer und Mux bei jedem Aufruf
+ * - delayMicroseconds() hat 1 us Aufloesung, die Datenblaetter brauchen ns
+ * - Bisher ca. 7 us Fixkosten pro Zyklus, mit Registerzugriff < 1 us
+ *
+ * Registerzugriff:
+ * - GPIO.out_w1ts / out_w1tc: Bit setzen/loeschen ohne Read-Modify-Write
+ *   (atomar, kein Lock noetig, andere Pins bleiben unberuehrt)
+ * - GPIO 32..48 liegen in out1_w1ts / out1_w1tc
+ *
+ * Pulsbreiten kommen aus config.h (pro Board-Revision, BOARD_REV).
+ * Die Pins muessen vorher per pinMode() als OUTPUT/INPUT konfiguriert sein.
+ */
+#ifndef FAST_GPIO_H
+#define FAST_GPIO_H
+
+// =============================================================================
+// INCLUDES
+// =============================================================================
+
+#include "config.h"
+#include <Arduino.h>
+#include "soc/gpio_struct.h"
+
+// =============================================================================
+// KONSTANTEN
+// =============================================================================
+
+// CPU-Takte pro Mikrosekunde (240 MHz → 240)
+constexpr uint32_t GPIO_CPU_MHZ = F_CPU / 1000000UL;
+
+/**
+ * @brief Rechnet Nanosekunden in CPU-Takte um (aufgerundet)
+ * @param ns Mindestdauer in Nanosekunden
+ * @return Anzahl CPU-Takte
+ */
+constexpr uint32_t gpio_ns_to_cycles(uint32_t ns) {
+    return (ns * GPIO_CPU_MHZ + 999) / 1000;
+}
+
+// =============================================================================
+// INLINE FUNKTIONEN
+// =============================================================================
+
+/**
+ * @brief Setzt einen Ausgang auf HIGH (ein Registerzugriff)
+ * @param pin GPIO-Nummer
+ */
+static inline void fast_gpio_high(uint8_t pin) {
+    if (pin < 32) {
+        GPIO.out_w1ts = (1UL << pin);
+    } else {
+        GPIO.out1_w1ts.val = (1UL << (pin - 32));
+    }
+}
+
+/**
+ * @brief Setzt einen Ausgang auf LOW (ein Registerzugriff)
+ * @param pin GPIO-Nummer
+ */
+static inline void fast_gpio_low(uint8_t pin) {
+    if (pin < 32) {
+        GPIO.out_w1tc = (1UL << pin);
+    } else {
+        GPIO.out1_w1tc.val = (1UL << (pin - 32));
+    }
+}
+
+/**
+ * @brief Liest einen Eingang (ein Registerzugriff)
+ * @param pin GPIO-Nummer
+ * @return true wenn HIGH
+ */
+static inline bool fast_gpio_read(uint8_t pin) {
+    if (pin < 32) {
+        return ((GPIO.in >> pin) & 1UL) != 0;
+    }
+    return ((GPIO.in1.val >> (pin - 32)) & 1UL) != 0;
+}
+
+/**
+ * @brief Wartet mindestens ns Nanosekunden (Busy-Wait auf CCOUNT)
+ * @param ns Mindestdauer in Nanosekunden
+ * @note Nur fuer Pulse im ns-Bereich, blockiert die CPU
+ */
+static inline void fast_delay_ns(uint32_t ns) {
+    const uint32_t cycles = gpio_ns_to_cycles(ns);
+    const uint32_t start = ESP.getCycleCount();
+    // Differenz statt Endwert: korrekt auch bei CCOUNT-Ueberlauf
+    while ((ESP.getCycleCount() - start) < cycles) {
+    }
+}
+
+/**
+ * @brief Erzeugt einen HIGH-Puls mit Mindestbreite
+ * @param pin GPIO-Nummer (Ruhepegel LOW)
+ * @param width_ns Mindestbreite in Nanosekunden
+ */
+static inline void fast_gpio_pulse_high(uint8_t pin, uint32_t width_ns) {
+    fast_gpio_high(pin);
+    fast_delay_ns(width_ns);
+    fast_gpio_low(pin);
+}
+
+#endif // FAST_GPIO_H
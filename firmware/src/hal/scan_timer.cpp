@@ -0,0 +1,70 @@
+/**
+ * @file scan_timer.cpp
+ * @brief ScanTimer Implementation (Arduino hw_timer, Task Notification)
+ */
+
+// =============================================================================
+// INCLUDES
+// =============================================================================
+
+#include "hal/scan_timer.h"
+
+// =============================================================================
+// MODUL-LOKALE KONSTANTEN
+// =============================================================================
+
+// Timer-Gruppe 0, Timer 0 (ledc nutzt eigene Timer)
+constexpr uint8_t SCAN_TIMER_NUM = 0;
+
+// APB-Takt 80 MHz / 80 = 1 MHz → Alarmwert in Mikrosekunden
+constexpr uint16_t SCAN_TIMER_DIVIDER = 80;
+
+// =============================================================================
+// MODUL-LOKALE VARIABLEN
+// =============================================================================
+
+// Zu weckender Task (von der ISR gelesen)
+static TaskHandle_t _notify_task = nullptr;
+
+// =============================================================================
+// ISR
+// =============================================================================
+
+/**
+ * @brief Timer-Alarm: IO-Task wecken
+ */
+static void IRAM_ATTR scan_timer_isr() {
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR(_notify_task, &woken);
+
+    // Sofort in den IO-Task wechseln, wenn er hoeher priorisiert ist
+    portYIELD_FROM_ISR(woken);
+}
+
+// =============================================================================
+// OEFFENTLICHE FUNKTIONEN
+// =============================================================================
+
+bool ScanTimer::begin(uint32_t period_us) {
+    if (_timer != nullptr || period_us == 0) {
+        return false; // Bereits gestartet bzw. ungueltig
+    }
+
+    _notify_task = xTaskGetCurrentTaskHandle();
+
+    _timer = timerBegin(SCAN_TIMER_NUM, SCAN_TIMER_DIVIDER, true);
+    if (_timer == nullptr) {
+        return false;
+    }
+
+    // Edge-Interrupt, Auto-Reload: Periode ohne Drift
+    timerAttachInterrupt(_timer, scan_timer_isr, true);
+    timerAlarmWrite(_timer, period_us, true);
+    timerAlarmEnable(_timer);
+    return true;
+}
+
+uint32_t ScanTimer::wait() {
+    // pdTRUE: Zaehler auf 0 → Rueckgabe = Ticks seit dem letzten wait()
+    return ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+}
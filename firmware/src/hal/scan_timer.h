@@ -0,0 +1,55 @@
+/**
+ * @file scan_timer.h
+ * @brief Hardware-Timer als Taktgeber fuer den IO-Zyklus
+ *
+ * Warum nicht vTaskDelayUntil()?
+ * - Periode ist an den FreeRTOS-Tick gebunden (1 ms bei 1 kHz Tick)
+ * - IO_PERIOD_MS kann damit nicht unter 1 ms sinken
+ *
+ * Ablauf:
+ * - Hardware-Timer (1 MHz Zaehltakt) loest periodisch eine ISR aus
+ * - ISR weckt den IO-Task per Direct Task Notification
+ * - IO-Task blockiert in wait() (kein Busy-Wait)
+ *
+ * Die ISR wird auf dem Core registriert, der begin() aufruft.
+ * begin() daher aus dem IO-Task selbst aufrufen.
+ */
+#ifndef SCAN_TIMER_H
+#define SCAN_TIMER_H
+
+// =============================================================================
+// INCLUDES
+// =============================================================================
+
+#include "config.h"
+#include <Arduino.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+// =============================================================================
+// CLASSES
+// =============================================================================
+
+/**
+ * @brief Periodischer Weckruf fuer genau einen Task
+ */
+class ScanTimer {
+public:
+    /**
+     * @brief Startet den Timer und bindet ihn an den aufrufenden Task
+     * @param period_us Periode in Mikrosekunden
+     * @return true bei Erfolg
+     */
+    bool begin(uint32_t period_us);
+
+    /**
+     * @brief Blockiert bis zum naechsten Timer-Tick
+     * @return Anzahl Ticks seit dem letzten Aufruf (> 1 = Perioden verpasst)
+     */
+    uint32_t wait();
+
+private:
+    hw_timer_t* _timer = nullptr; /**< Arduino-Timer-Handle */
+};
+
+#endif // SCAN_TIMER_H
@@ -1,6 +1,6 @@
 /**
  * @file spi_bus.cpp
- * @brief SPI-Bus Implementation
+ * @brief SPI-Bus Implementation (Arduino- und ESP-IDF-DMA-Backend)
  */
 
 // =============================================================================
@@ -9,19 +9,102 @@
 
 #include "hal/spi_bus.h"
 
+#if SPI_BACKEND_DMA
+#include "esp_heap_caps.h"
+#endif
+
+// =============================================================================
+// MODUL-LOKALE KONSTANTEN
+// =============================================================================
+
+/**
+ * @brief Takt und Mode pro Geraete-Profil
+ */
+typedef struct spi_device_cfg {
+    uint32_t hz;  /**< SPI-Takt */
+    uint8_t mode; /**< SPI_MODE0..3 (Arduino = IDF Nummerierung) */
+} spi_device_cfg_t;
+
+static const spi_device_cfg_t DEVICE_CFG[SPI_DEV_COUNT] = {
+    {SPI_HZ_BTN, SPI_MODE_BTN},   // SPI_DEV_BTN
+    {SPI_HZ_LED, SPI_MODE_LED},   // SPI_DEV_LED
+    {SPI_HZ_SCAN, SPI_MODE_SCAN}, // SPI_DEV_SCAN
+};
+
 // =============================================================================
 // OEFFENTLICHE FUNKTIONEN
 // =============================================================================
 
-void SpiBus::begin(int sck, int miso, int mosi) {
+bool SpiBus::begin(int sck, int miso, int mosi) {
     // Mutex nur einmal erstellen (idempotent bei mehrfachem Aufruf)
     if (_mtx == nullptr) {
         _mtx = xSemaphoreCreateMutex();
+        if (_mtx == nullptr) {
+            return false;
+        }
+    }
+    if (_ready) {
+        return true; // Bereits initialisiert
+    }
+
+#if SPI_BACKEND_DMA
+    // DMA kann nur aus internem RAM lesen/schreiben
+    if (_tx_buf == nullptr) {
+        _tx_buf = static_cast<uint8_t *>(
+            heap_caps_malloc(SPI_MAX_TRANSFER, MALLOC_CAP_DMA));
+    }
+    if (_rx_buf == nullptr) {
+        _rx_buf = static_cast<uint8_t *>(
+            heap_caps_malloc(SPI_MAX_TRANSFER, MALLOC_CAP_DMA));
+    }
+    if (_tx_buf == nullptr || _rx_buf == nullptr) {
+        return false;
+    }
+
+    spi_bus_config_t bus_cfg = {};
+    bus_cfg.mosi_io_num = mosi;
+    bus_cfg.miso_io_num = miso;
+    bus_cfg.sclk_io_num = sck;
+    bus_cfg.quadwp_io_num = -1;
+    bus_cfg.quadhd_io_num = -1;
+    bus_cfg.max_transfer_sz = SPI_MAX_TRANSFER;
+    if (spi_bus_initialize(SPI2_HOST, &bus_cfg, SPI_DMA_CH_AUTO) != ESP_OK) {
+        return false;
     }
 
+    // Ein IDF-Geraet pro Profil: Takt/Mode wechseln ohne Reconfigure
+    // spics_io_num = -1: kein Hardware-CS (P/S und RCK per GPIO)
+    for (size_t i = 0; i < SPI_DEV_COUNT; ++i) {
+        spi_device_interface_config_t dev_cfg = {};
+        dev_cfg.mode = DEVICE_CFG[i].mode;
+        dev_cfg.clock_speed_hz = static_cast<int>(DEVICE_CFG[i].hz);
+        dev_cfg.spics_io_num = -1;
+        dev_cfg.queue_size = 1;
+        if (spi_bus_add_device(SPI2_HOST, &dev_cfg, &_dev[i]) != ESP_OK) {
+            // Bereits angelegte Geraete und Bus wieder freigeben
+            for (size_t j = 0; j < i; ++j) {
+                spi_bus_remove_device(_dev[j]);
+                _dev[j] = nullptr;
+            }
+            _dev[i] = nullptr;
+            spi_bus_free(SPI2_HOST);
+            return false;
+        }
+    }
+#else
+    // Statische Puffer reichen (kein DMA)
+    static uint8_t tx_buf[SPI_MAX_TRANSFER];
+    static uint8_t rx_buf[SPI_MAX_TRANSFER];
+    _tx_buf = tx_buf;
+    _rx_buf = rx_buf;
+
     // ESP32 SPI.begin() erlaubt flexible Pin-Zuordnung
     // -1 fuer SS = kein Hardware-SS (wir nutzen Software-CS)
     SPI.begin(sck, miso, mosi, -1);
+#endif
+
+    _ready = true;
+    return true;
 }
 
 void SpiBus::lock() {
@@ -36,3 +119,75 @@ void SpiBus::unlock() {
         xSemaphoreGive(_mtx);
     }
 }
+
+bool SpiBus::transfer(spi_device_e dev, const uint8_t *tx, uint8_t *rx,
+                      size_t len) {
+    if (!startTransfer(dev, tx, len)) {
+        return false;
+    }
+    return finishTransfer(rx, len);
+}
+
+bool SpiBus::startTransfer(spi_device_e dev, const uint8_t *tx, size_t len) {
+    // Ohne erfolgreiches begin(): Treiber nehmen ihren Bus-Fehler-Pfad
+    if (!_ready || len == 0 || len > SPI_MAX_TRANSFER) {
+        return false;
+    }
+
+    // Bus bleibt bis finishTransfer() gesperrt
+    lock();
+
+    // Sendedaten in eigenen (ggf. DMA-faehigen) Puffer kopieren:
+    // Aufrufer darf seinen Puffer sofort wieder aendern
+    if (tx != nullptr) {
+        memcpy(_tx_buf, tx, len);
+    } else {
+        memset(_tx_buf, 0x00, len);
+    }
+
+#if SPI_BACKEND_DMA
+    _trans = {};
+    _trans.length = len * 8; // in Bits
+    _trans.tx_buffer = _tx_buf;
+    _trans.rx_buffer = _rx_buf;
+    _active = _dev[dev];
+
+    // Nicht-blockierend einreihen, DMA uebernimmt den Transfer
+    if (spi_device_queue_trans(_active, &_trans, 0) != ESP_OK) {
+        unlock();
+        return false;
+    }
+#else
+    // Arduino-Backend: ein Aufruf fuer den ganzen Puffer (synchron)
+    SPI.beginTransaction(
+        SPISettings(DEVICE_CFG[dev].hz, MSBFIRST, DEVICE_CFG[dev].mode));
+    SPI.transferBytes(_tx_buf, _rx_buf, len);
+    SPI.endTransaction();
+#endif
+
+    _pending = true;
+    return true;
+}
+
+bool SpiBus::finishTransfer(uint8_t *rx, size_t len) {
+    if (!_pending) {
+        return false;
+    }
+
+    bool ok = true;
+
+#if SPI_BACKEND_DMA
+    // Blockiert im Semaphore-Wait (kein Busy-Wait), Task darf schlafen
+    spi_transaction_t *done = nullptr;
+    ok = (spi_device_get_trans_result(_active, &done, portMAX_DELAY) == ESP_OK);
+    _active = nullptr;
+#endif
+
+    if (ok && rx != nullptr) {
+        memcpy(rx, _rx_buf, len);
+    }
+
+    _pending = false;
+    unlock();
+    return ok;
+}
@@ -2,8 +2,15 @@
  * @file spi_bus.h
  * @brief SPI-Bus Abstraktion mit FreeRTOS Mutex
  *
- * Stellt thread-sichere SPI-Transaktionen bereit.
- * SpiGuard (RAII) garantiert Transaction-Ende auch bei Exceptions.
+ * Stellt thread-sichere SPI-Transaktionen bereit: Jeder Transfer sperrt
+ * den Bus selbst (Mutex) und stellt Takt + Mode des Geraets ein.
+ *
+ * Zwei Backends (Build-Option SPI_BACKEND_DMA in config.h):
+ * - Arduino: SPI.transferBytes(), ein blockierender Aufruf pro Transfer
+ * - ESP-IDF: spi_master mit DMA-Puffern, spi_device_queue_trans()
+ *
+ * Treiber nutzen nur transfer() bzw. startTransfer()/finishTransfer().
+ * Zwischen Start und Ende darf der Aufrufer andere Arbeit erledigen.
  */
 #ifndef SPI_BUS_H
 #define SPI_BUS_H
@@ -12,11 +19,37 @@
 // INCLUDES
 // =============================================================================
 
+#include "config.h"
 #include <Arduino.h>
 #include <SPI.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/semphr.h"
 
+#if SPI_BACKEND_DMA
+#include "driver/spi_master.h"
+#endif
+
+// =============================================================================
+// KONSTANTEN
+// =============================================================================
+
+// Groesster Transfer auf dem Bus (laengste Kette bzw. Full-Duplex-Frame)
+constexpr size_t SPI_MAX_TRANSFER = SCAN_BYTES;
+
+// =============================================================================
+// TYPES
+// =============================================================================
+
+/**
+ * @brief Geraete-Profile auf dem gemeinsamen Bus (Takt + Mode)
+ */
+typedef enum spi_device {
+    SPI_DEV_BTN,  /**< CD4021B: SPI_HZ_BTN, SPI_MODE_BTN */
+    SPI_DEV_LED,  /**< 74HC595: SPI_HZ_LED, SPI_MODE_LED */
+    SPI_DEV_SCAN, /**< Full-Duplex: SPI_HZ_SCAN, SPI_MODE_SCAN */
+    SPI_DEV_COUNT
+} spi_device_e;
+
 // =============================================================================
 // CLASSES
 // =============================================================================
@@ -31,8 +64,10 @@ public:
      * @param sck Clock-Pin
      * @param miso MISO-Pin
      * @param mosi MOSI-Pin
+     * @return false wenn Puffer, Bus oder ein Geraet nicht angelegt werden
+     *         konnten; transfer()/startTransfer() liefern dann immer false
      */
-    void begin(int sck, int miso, int mosi);
+    bool begin(int sck, int miso, int mosi);
 
     /**
      * @brief Sperrt den Bus (blockiert bis frei)
@@ -44,48 +79,46 @@ public:
      */
     void unlock();
 
-private:
-    SemaphoreHandle_t _mtx = nullptr;  /**< FreeRTOS Mutex */
-};
-
-/**
- * @brief RAII Guard fuer SPI-Transaktionen
- *
- * Verwendung:
- * @code
- * {
- *     SpiGuard g(bus, settings);
- *     SPI.transfer(...);
- * }  // Automatisch: endTransaction() + unlock()
- * @endcode
- */
-class SpiGuard {
-public:
     /**
-     * @brief Startet SPI-Transaktion mit Lock
-     * @param bus SpiBus-Instanz
-     * @param settings SPI-Einstellungen
+     * @brief Blockierender Full-Duplex-Transfer
+     * @param dev Geraete-Profil (Takt + Mode)
+     * @param tx Sendedaten [len] (nullptr = 0x00 senden)
+     * @param rx Empfangspuffer [len] (nullptr = verwerfen)
+     * @param len Anzahl Bytes (max. SPI_MAX_TRANSFER)
+     * @return true bei Erfolg
      */
-    SpiGuard(SpiBus& bus, const SPISettings& settings)
-        : _bus(bus) {
-        _bus.lock();
-        SPI.beginTransaction(settings);
-    }
+    bool transfer(spi_device_e dev, const uint8_t* tx, uint8_t* rx, size_t len);
 
     /**
-     * @brief Beendet Transaktion und gibt Lock frei
+     * @brief Startet einen Transfer im Hintergrund (sperrt den Bus)
+     * @param dev Geraete-Profil (Takt + Mode)
+     * @param tx Sendedaten [len] (nullptr = 0x00 senden), wird kopiert
+     * @param len Anzahl Bytes (max. SPI_MAX_TRANSFER)
+     * @return true wenn gestartet (dann finishTransfer() Pflicht)
+     * @note Arduino-Backend: Transfer laeuft bereits hier synchron
      */
-    ~SpiGuard() {
-        SPI.endTransaction();
-        _bus.unlock();
-    }
+    bool startTransfer(spi_device_e dev, const uint8_t* tx, size_t len);
 
-    // Nicht kopierbar (wuerde doppeltes unlock verursachen)
-    SpiGuard(const SpiGuard&) = delete;
-    SpiGuard& operator=(const SpiGuard&) = delete;
+    /**
+     * @brief Wartet auf den gestarteten Transfer und gibt den Bus frei
+     * @param rx Empfangspuffer [len] (nullptr = verwerfen)
+     * @param len Anzahl Bytes (wie bei startTransfer)
+     * @return true bei Erfolg
+     */
+    bool finishTransfer(uint8_t* rx, size_t len);
 
 private:
-    SpiBus& _bus;  /**< Referenz auf den Bus */
+    SemaphoreHandle_t _mtx = nullptr;  /**< FreeRTOS Mutex */
+    bool _ready = false;               /**< begin() erfolgreich */
+    bool _pending = false;             /**< startTransfer() ohne finish */
+    uint8_t* _tx_buf = nullptr;        /**< Sendepuffer (DMA-faehig) */
+    uint8_t* _rx_buf = nullptr;        /**< Empfangspuffer (DMA-faehig) */
+
+#if SPI_BACKEND_DMA
+    spi_device_handle_t _dev[SPI_DEV_COUNT] = {};  /**< IDF-Geraete */
+    spi_device_handle_t _active = nullptr;         /**< Geraet des laufenden Transfers */
+    spi_transaction_t _trans = {};                 /**< Laufende Transaktion */
+#endif
 };
 
 #endif // SPI_BUS_H
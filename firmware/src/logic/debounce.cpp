@@ -14,21 +14,25 @@
 // =============================================================================
 
 void Debouncer::init() {
-    // Alle Taster als "losgelassen" initialisieren (0xFF = Active-Low)
-    for (size_t i = 0; i < BTN_BYTES; ++i) {
-        _raw_prev[i] = 0xFF;
-    }
+    // Alle Taster als "losgelassen" initialisieren (1 = Active-Low)
+    _raw_prev.fill(true);
 
     // Timer auf 0 = sofortige Uebernahme beim ersten echten Tastendruck
     for (size_t i = 0; i < BTN_COUNT; ++i) {
         _last_change[i] = 0;
+        _press_ms[i] = 0;
     }
+
+    _eager = DEBOUNCE_EAGER;
 }
 
-bool Debouncer::update(uint32_t now_ms, const uint8_t *raw, uint8_t *deb) {
+bool Debouncer::update(uint32_t now_ms, const btn_bits_t &raw,
+                       btn_bits_t &deb) {
     bool any_changed = false;
 
-    for (uint8_t id = 1; id <= BTN_COUNT; ++id) {
+    // Index statt ID als Zaehler: uint8_t liefe bei BTN_COUNT = 255 nie ueber
+    for (size_t i = 0; i < BTN_COUNT; ++i) {
+        const uint8_t id = static_cast<uint8_t>(i + 1);
         const bool raw_now = activeLow_pressed(raw, id);
         const bool raw_prev = activeLow_pressed(_raw_prev, id);
         const bool deb_now = activeLow_pressed(deb, id);
@@ -45,16 +49,26 @@ bool Debouncer::update(uint32_t now_ms, const uint8_t *raw, uint8_t *deb) {
             (now_ms - _last_change[id - 1] >= DEBOUNCE_MS);
         const bool states_differ = (raw_now != deb_now);
 
-        if (timer_expired && states_differ) {
+        // Eager: Erster Roh-Wechsel auf "gedrueckt" zaehlt sofort
+        if (_eager && states_differ && raw_now) {
+            activeLow_setPressed(deb, id, true);
+            _press_ms[id - 1] = now_ms;
+            any_changed = true;
+            continue;
+        }
+
+        // Eager: Waehrend der Sperre kein Release (Prellen nach dem Press)
+        const bool locked =
+            _eager && (now_ms - _press_ms[id - 1] < DEBOUNCE_LOCKOUT_MS);
+
+        if (timer_expired && states_differ && !locked) {
             activeLow_setPressed(deb, id, raw_now);
             any_changed = true;
         }
     }
 
     // Rohzustand fuer naechsten Zyklus merken
-    for (size_t i = 0; i < BTN_BYTES; ++i) {
-        _raw_prev[i] = raw[i];
-    }
+    _raw_prev = raw;
 
     return any_changed;
 }
@@ -10,6 +10,12 @@
  * Algorithmus:
  * 1. Bei jeder Rohwert-Aenderung: Timer zuruecksetzen
  * 2. Wenn Timer abgelaufen UND Rohwert != Debounced: Uebernehmen
+ *
+ * Eager-Modus (Leading-Edge, setEager(true)):
+ * 1. Press sofort beim ersten Roh-Wechsel uebernehmen
+ * 2. Danach DEBOUNCE_LOCKOUT_MS Sperre (Prellen wird ignoriert)
+ * 3. Release wie oben zeitbasiert bestaetigen (fruehestens nach Sperre)
+ * PRESS kommt damit ca. DEBOUNCE_MS frueher.
  */
 #ifndef DEBOUNCE_H
 #define DEBOUNCE_H
@@ -34,7 +40,7 @@ public:
     /**
      * @brief Konstruktor - initialisiert Member auf sichere Werte
      */
-    Debouncer() : _raw_prev{}, _last_change{} {}
+    Debouncer() : _raw_prev(), _last_change{}, _press_ms{}, _eager(false) {}
 
     /**
      * @brief Initialisiert interne Zustaende fuer Betrieb
@@ -44,15 +50,29 @@ public:
     /**
      * @brief Aktualisiert Debounce-Zustand
      * @param now_ms Aktuelle Zeit in Millisekunden
-     * @param raw Aktueller Rohzustand [BTN_BYTES]
-     * @param deb Entprellter Zustand [BTN_BYTES] (wird modifiziert)
+     * @param raw Aktueller Rohzustand
+     * @param deb Entprellter Zustand (wird modifiziert)
      * @return true wenn sich etwas geaendert hat
      */
-    bool update(uint32_t now_ms, const uint8_t* raw, uint8_t* deb);
+    bool update(uint32_t now_ms, const btn_bits_t& raw, btn_bits_t& deb);
+
+    /**
+     * @brief Waehlt die Press-Policy
+     * @param eager true = Leading-Edge mit Sperre, false = zeitbasiert
+     */
+    void setEager(bool eager) { _eager = eager; }
+
+    /**
+     * @brief Aktuelle Press-Policy
+     * @return true wenn Leading-Edge aktiv
+     */
+    bool eager() const { return _eager; }
 
 private:
-    uint8_t _raw_prev[BTN_BYTES];       /**< Rohzustand vom letzten Zyklus */
+    btn_bits_t _raw_prev;               /**< Rohzustand vom letzten Zyklus */
     uint32_t _last_change[BTN_COUNT];   /**< Zeitpunkt der letzten Aenderung pro Taster */
+    uint32_t _press_ms[BTN_COUNT];      /**< Zeitpunkt des Eager-Press (Sperrbeginn) */
+    bool _eager;                        /**< Leading-Edge-Policy aktiv */
 };
 
 #endif // DEBOUNCE_H
@@ -9,61 +9,51 @@
 
 #include "logic/selection.h"
 
-// =============================================================================
-// PRIVATE HILFSFUNKTIONEN
-// =============================================================================
-
-/**
- * @brief Prueft ob irgendein Taster gedrueckt ist
- * @param deb Entprellter Zustand
- * @return true wenn mindestens ein Taster gedrueckt
- */
-static bool any_pressed(const uint8_t *deb) {
-    for (size_t i = 0; i < BTN_BYTES; ++i) {
-        if (deb[i] != 0xFF) {
-            return true; // Active-Low: != 0xFF = gedrueckt
-        }
-    }
-    return false;
-}
-
 // =============================================================================
 // OEFFENTLICHE FUNKTIONEN
 // =============================================================================
 
 void Selection::init() {
     // Alle Taster als "losgelassen" initialisieren
-    for (size_t i = 0; i < BTN_BYTES; ++i) {
-        _deb_prev[i] = 0xFF;
-    }
+    _deb_prev.fill(true);
 }
 
-bool Selection::update(const uint8_t *deb_now, uint8_t &active_id) {
+bool Selection::update(const btn_bits_t &deb_now, uint8_t &active_id) {
     const uint8_t prev_active = active_id;
     uint8_t new_active = active_id;
+    bool edge_found = false;
+    bool any_pressed = false;
+
+    // Flanken-Erkennung wortweise: Wer wurde gerade gedrueckt?
+    // Rueckwaerts von der hoechsten ID: "last press wins" bei mehreren
+    // Flanken, d.h. die hoechste ID gewinnt (wie beim Durchlauf 1..BTN_COUNT)
+    for (size_t w = BTN_WORDS; w-- > 0;) {
+        const uint32_t now = deb_now.word(w);
+        const uint32_t valid = btn_bits_t::valid_mask(w);
+
+        // Active-Low: Steigende Flanke = war 1 (los), ist jetzt 0 (gedrueckt)
+        const uint32_t edges = _deb_prev.word(w) & ~now & valid;
+
+        if (!edge_found && edges != 0) {
+            // Hoechste ID im Wort per Count-Leading/Trailing-Zeros
+            new_active = btn_bits_t::last_id_in_word(w, edges);
+            edge_found = true;
+        }
 
-    // Flanken-Erkennung: Wer wurde gerade gedrueckt?
-    // Iteriert von ID 1 bis BTN_COUNT, "last press wins" bei mehreren Flanken
-    for (uint8_t id = 1; id <= BTN_COUNT; ++id) {
-        const bool now_pressed = activeLow_pressed(deb_now, id);
-        const bool prev_pressed = activeLow_pressed(_deb_prev, id);
-
-        // Steigende Flanke = gerade gedrueckt (war los, ist jetzt gedrueckt)
-        if (now_pressed && !prev_pressed) {
-            new_active = id;
+        // Im selben Durchlauf: Ist irgendein Taster gedrueckt?
+        if ((~now & valid) != 0) {
+            any_pressed = true;
         }
     }
 
+    // Zustand fuer naechsten Zyklus merken
+    _deb_prev = deb_now;
+
     // LATCH_SELECTION = false: Auswahl erlischt wenn nichts mehr gedrueckt
-    if (!LATCH_SELECTION && !any_pressed(deb_now)) {
+    if (!LATCH_SELECTION && !any_pressed) {
         new_active = 0;
     }
 
-    // Zustand fuer naechsten Zyklus merken
-    for (size_t i = 0; i < BTN_BYTES; ++i) {
-        _deb_prev[i] = deb_now[i];
-    }
-
     active_id = new_active;
     return (active_id != prev_active);
 }
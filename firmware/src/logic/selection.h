@@ -9,6 +9,9 @@
  * - Flanken-basiert: Reagiert nur auf Uebergaenge (nicht gedrueckt -> gedrueckt)
  * - LATCH_SELECTION=true: Auswahl bleibt nach Loslassen bestehen
  * - LATCH_SELECTION=false: Auswahl erlischt wenn nichts gedrueckt
+ *
+ * Flanken und "irgendein Taster gedrueckt" werden wortweise (32 Taster pro
+ * Operation) in einem Durchlauf bestimmt, der Gewinner per Count-Trailing-Zeros.
  */
 #ifndef SELECTION_H
 #define SELECTION_H
@@ -33,7 +36,7 @@ public:
     /**
      * @brief Konstruktor - initialisiert Member auf sichere Werte
      */
-    Selection() : _deb_prev{} {}
+    Selection() : _deb_prev() {}
 
     /**
      * @brief Initialisiert interne Zustaende fuer Betrieb
@@ -42,14 +45,14 @@ public:
 
     /**
      * @brief Aktualisiert Auswahl basierend auf Flanken
-     * @param deb_now Aktueller entprellter Zustand [BTN_BYTES]
+     * @param deb_now Aktueller entprellter Zustand
      * @param active_id Aktuelle Auswahl (wird modifiziert)
      * @return true wenn sich active_id geaendert hat
      */
-    bool update(const uint8_t* deb_now, uint8_t& active_id);
+    bool update(const btn_bits_t& deb_now, uint8_t& active_id);
 
 private:
-    uint8_t _deb_prev[BTN_BYTES];  /**< Debounced-Zustand vom letzten Zyklus */
+    btn_bits_t _deb_prev;  /**< Debounced-Zustand vom letzten Zyklus */
 };
 
 #endif // SELECTION_H
@@ -0,0 +1,57 @@
+/**
+ * @file vertical_debounce.cpp
+ * @brief VerticalDebouncer Implementation
+ */
+
+// =============================================================================
+// INCLUDES
+// =============================================================================
+
+#include "logic/vertical_debounce.h"
+
+// =============================================================================
+// OEFFENTLICHE FUNKTIONEN
+// =============================================================================
+
+void VerticalDebouncer::init() {
+    // Alle Zaehler auf 0
+    memset(_planes, 0, sizeof(_planes));
+}
+
+bool VerticalDebouncer::update(uint32_t /*now_ms*/, const btn_bits_t &raw,
+                               btn_bits_t &deb) {
+    uint32_t any_changed = 0;
+
+    for (size_t w = 0; w < BTN_WORDS; ++w) {
+        // Bits, bei denen Rohwert und entprellter Wert abweichen
+        // Unbelegte Eingaenge (Tail-Bits) werden nie entprellt
+        const uint32_t delta =
+            (raw.word(w) ^ deb.word(w)) & btn_bits_t::valid_mask(w);
+
+        // Zaehler +1 wo abweichend, sonst 0 (Ripple-Carry ueber die Planes)
+        uint32_t carry = delta;
+        for (uint8_t p = 0; p < DEBOUNCE_PLANES; ++p) {
+            const uint32_t bit = _planes[p][w] & delta;
+            _planes[p][w] = bit ^ carry;
+            carry &= bit;
+        }
+
+        // Schwelle erreicht? Alle Planes muessen dem Schwellwert entsprechen
+        uint32_t hit = delta;
+        for (uint8_t p = 0; p < DEBOUNCE_PLANES; ++p) {
+            hit &= ((DEBOUNCE_THRESHOLD >> p) & 1u) ? _planes[p][w]
+                                                    : ~_planes[p][w];
+        }
+
+        // Uebernehmen und Zaehler zuruecksetzen
+        if (hit != 0) {
+            deb.set_word(w, deb.word(w) ^ hit);
+            for (uint8_t p = 0; p < DEBOUNCE_PLANES; ++p) {
+                _planes[p][w] &= ~hit;
+            }
+            any_changed |= hit;
+        }
+    }
+
+    return any_changed != 0;
+}
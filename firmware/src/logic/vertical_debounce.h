@@ -0,0 +1,104 @@
+/**
+ * @file vertical_debounce.h
+ * @brief Vertikaler-Zaehler-Entpreller (bit-sliced) fuer lange Taster-Ketten
+ *
+ * Warum vertikale Zaehler?
+ * - Alle Taster eines 32-Bit-Worts werden mit wenigen AND/XOR entprellt
+ * - Kein Timer pro Taster: 3 Bit-Planes statt uint32_t[BTN_COUNT]
+ * - Bei 100 Tastern: 4 Woerter x 3 Planes = 48 Bytes statt 400 Bytes
+ *
+ * Algorithmus (pro Bit-Position, parallel fuer 32 Taster):
+ * 1. Rohwert == Debounced: Zaehler auf 0
+ * 2. Rohwert != Debounced: Zaehler +1
+ * 3. Zaehler == DEBOUNCE_THRESHOLD: Rohwert uebernehmen, Zaehler auf 0
+ *
+ * Aequivalenz zum zeitbasierten Debouncer:
+ * Der Zeitstempel wird beim Wechsel-Sample gesetzt, die Uebernahme erfolgt
+ * DEBOUNCE_SAMPLES Zyklen spaeter. Der Zaehler zaehlt das Wechsel-Sample mit,
+ * daher Schwelle = DEBOUNCE_SAMPLES + 1. Gilt bei fester Periode IO_PERIOD_US
+ * und nur, wenn IO_PERIOD_US ein Vielfaches von 1000 us ist: Der Debouncer
+ * rechnet in ganzen ms (millis()), bei z.B. 250 us faellt die Uebernahme je
+ * nach Phase einen Zyklus frueher oder spaeter als hier.
+ * Geprueft in der Host-Simulation (sim/main.cpp, check_debounce_engines()).
+ */
+#ifndef VERTICAL_DEBOUNCE_H
+#define VERTICAL_DEBOUNCE_H
+
+// =============================================================================
+// INCLUDES
+// =============================================================================
+
+#include "bitops.h"
+#include "config.h"
+#include <Arduino.h>
+
+// =============================================================================
+// KONSTANTEN
+// =============================================================================
+
+// Stabile Samples nach dem Wechsel (aufrunden: 30 ms / 5 ms → 6)
+constexpr uint32_t DEBOUNCE_SAMPLES =
+    (DEBOUNCE_MS * 1000 + IO_PERIOD_US - 1) / IO_PERIOD_US;
+
+// Zaehlerstand fuer Uebernahme (inkl. Wechsel-Sample)
+constexpr uint32_t DEBOUNCE_THRESHOLD = DEBOUNCE_SAMPLES + 1;
+
+/**
+ * @brief Anzahl Bits fuer einen Zaehlerwert
+ * @param v Maximaler Zaehlerwert
+ * @return Benoetigte Bit-Planes
+ */
+constexpr uint8_t vc_bit_width(uint32_t v) {
+    return (v == 0) ? 0 : static_cast<uint8_t>(1 + vc_bit_width(v >> 1));
+}
+
+// Bit-Planes pro Zaehler (Schwelle 7 → 3 Planes)
+constexpr uint8_t DEBOUNCE_PLANES = vc_bit_width(DEBOUNCE_THRESHOLD);
+
+static_assert(DEBOUNCE_PLANES <= 8, "DEBOUNCE_MS / IO_PERIOD_US too large");
+
+// =============================================================================
+// CLASSES
+// =============================================================================
+
+/**
+ * @brief Bit-sliced Entpreller fuer Taster (gleiche API wie Debouncer)
+ */
+class VerticalDebouncer {
+public:
+    /**
+     * @brief Konstruktor - initialisiert Member auf sichere Werte
+     */
+    VerticalDebouncer() : _planes{} {}
+
+    /**
+     * @brief Initialisiert interne Zustaende fuer Betrieb
+     */
+    void init();
+
+    /**
+     * @brief Aktualisiert Debounce-Zustand
+     * @param now_ms Aktuelle Zeit (ungenutzt, Takt = Aufrufrate)
+     * @param raw Aktueller Rohzustand
+     * @param deb Entprellter Zustand (wird modifiziert)
+     * @return true wenn sich etwas geaendert hat
+     * @note Muss genau einmal pro IO_PERIOD_US aufgerufen werden
+     */
+    bool update(uint32_t now_ms, const btn_bits_t& raw, btn_bits_t& deb);
+
+    /**
+     * @brief Press-Policy (nur zeitbasiert unterstuetzt, Aufruf ignoriert)
+     */
+    void setEager(bool) {}
+
+    /**
+     * @brief Aktuelle Press-Policy
+     * @return Immer false (zeitbasiert)
+     */
+    bool eager() const { return false; }
+
+private:
+    uint32_t _planes[DEBOUNCE_PLANES][BTN_WORDS]; /**< Zaehler-Bits, Plane 0 = LSB */
+};
+
+#endif // VERTICAL_DEBOUNCE_H
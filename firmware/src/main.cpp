@@ -3,11 +3,11 @@
  * @brief Selection Panel Entry Point (v2.5.0)
  *
  * Aufbau:
- * - setup() erstellt Queue und startet Tasks
+ * - setup() startet Tasks mit dem gemeinsamen Log-Kanal
  * - loop() ist leer (Tasks uebernehmen die Arbeit)
  *
- * Warum Queue in main.cpp und nicht in einem Task?
- * Queue muss vor beiden Tasks existieren.
+ * Warum Log-Kanal in main.cpp und nicht in einem Task?
+ * Kanal muss vor beiden Tasks existieren.
  * main.cpp ist der natuerliche Ort fuer "Verbindung" zwischen Modulen.
  *
  * Serial-Initialisierung:
@@ -24,7 +24,6 @@
 #include <Arduino.h>
 
 #include "freertos/FreeRTOS.h"
-#include "freertos/queue.h"
 
 #include "app/io_task.h"
 #include "app/serial_task.h"
@@ -33,29 +32,26 @@
 // MODUL-LOKALE VARIABLEN
 // =============================================================================
 
-static QueueHandle_t _log_queue = nullptr;
+// Lock-freie Ringe IO -> Serial (statisch, kein Heap)
+static log_channel_t _log_channel;
 
 // =============================================================================
 // ARDUINO ENTRY POINTS
 // =============================================================================
 
 /**
- * @brief Arduino Setup - Erstellt Queue und startet Tasks
+ * @brief Arduino Setup - Startet Tasks
  */
 void setup() {
     // USB-CDC braucht Zeit zum Initialisieren
     // Serial.begin() erfolgt in serial_task.cpp
     delay(1500);
 
-    // Queue fuer Log-Events erstellen
-    // Groesse: LOG_QUEUE_LEN Events, jedes sizeof(log_event_t) Bytes
-    _log_queue = xQueueCreate(LOG_QUEUE_LEN, sizeof(log_event_t));
-
-    // Tasks starten
+    // Tasks starten (Serial zuerst: IO weckt ihn per Task-Notification)
     // IO hoch: harter 200 Hz Zyklus, soll jitterarm bleiben
     // Serial niedriger: darf drosseln, darf IO nicht stoeren
-    start_io_task(_log_queue);
-    start_serial_task(_log_queue);
+    start_serial_task(&_log_channel);
+    start_io_task(&_log_channel);
 }
 
 /**
@@ -0,0 +1,11 @@
+#!/usr/bin/env bash
+# Microbenchmark des IO-Hot-Paths auf dem Host (bench/main.cpp)
+# Aufruf: tools/bench.sh [panelgroessen...] > bench.txt   (Standard: 10 100 255)
+set -euo pipefail
+
+cd "$(dirname "$0")/.."
+
+for size in ${*:-10 100 255}; do
+  PLATFORMIO_BUILD_FLAGS="-DPANEL_SIZE=${size}" pio run -s -e bench_native >&2
+  .pio/build/bench_native/program
+done
@@ -0,0 +1,74 @@
+#!/usr/bin/env python3
+"""
+Benchmark-Vergleich: zwei Ausgaben von bench/main.cpp
+=====================================================
+
+Liest die Zeilen "BENCH <panel> <name> <median_ns> <min_ns> <allocs>" aus
+einer Referenz und einem neuen Lauf und meldet pro Messung die Aenderung
+des Minimums (am wenigsten von Interrupts und Host-Last gestoert).
+Regression:
+- Minimum mehr als <toleranz> Prozent und mehr als MIN_DELTA_NS langsamer
+- Heap-Allokationen im Hot Path (allocs > Referenz)
+
+Nur Laeufe derselben Zeitbasis vergleichen (Host mit Host, ESP32 mit ESP32).
+Auf dem Host schwanken Werte mit der Last; ESP32-Werte (CCOUNT) sind stabil.
+
+Aufruf:
+    tools/bench.sh > neu.txt
+    python3 tools/bench_compare.py referenz.txt neu.txt 15
+Exit-Code 1 bei Regression.
+"""
+
+import sys
+
+DEFAULT_TOLERANCE_PCT = 15.0
+MIN_DELTA_NS = 2.0  # Darunter Messrauschen (wenige Takte)
+
+
+def load(path: str) -> dict:
+    results = {}
+    with open(path, encoding="utf-8", errors="replace") as f:
+        for line in f:
+            parts = line.split()
+            if len(parts) != 6 or parts[0] != "BENCH":
+                continue
+            key = (int(parts[1]), parts[2])
+            results[key] = (float(parts[3]), float(parts[4]), int(parts[5]))
+    return results
+
+
+def compare(base: dict, new: dict, tolerance: float) -> int:
+    regressions = 0
+    print(f"{'panel':>5} {'name':<16} {'ref':>9} {'neu':>9} {'delta':>8}")
+    for key in sorted(new):
+        if key not in base:
+            continue
+        _, ref_min, ref_allocs = base[key]
+        _, new_min, new_allocs = new[key]
+        delta = (new_min - ref_min) / ref_min * 100 if ref_min > 0 else 0.0
+
+        flags = []
+        if delta > tolerance and new_min - ref_min > MIN_DELTA_NS:
+            flags.append("LANGSAMER")
+        if new_allocs > ref_allocs:
+            flags.append(f"ALLOCS {ref_allocs}->{new_allocs}")
+        if flags:
+            regressions += 1
+
+        panel, name = key
+        print(f"{panel:>5} {name:<16} {ref_min:>9.1f} {new_min:>9.1f} {delta:>+7.1f}%  {' '.join(flags)}")
+
+    missing = sorted(set(base) - set(new))
+    for panel, name in missing:
+        print(f"{panel:>5} {name:<16} fehlt im neuen Lauf")
+
+    print(f"{regressions} Regression(en), Toleranz {tolerance:.0f}%")
+    return regressions
+
+
+if __name__ == "__main__":
+    if len(sys.argv) < 3:
+        print(__doc__)
+        sys.exit(1)
+    tolerance = float(sys.argv[3]) if len(sys.argv) > 3 else DEFAULT_TOLERANCE_PCT
+    sys.exit(1 if compare(load(sys.argv[1]), load(sys.argv[2]), tolerance) > 0 else 0)
@@ -0,0 +1,113 @@
+#!/usr/bin/env python3
+"""
+LED-Pipeline: getaggte LED-Befehle mit Bestaetigung nach dem Latch
+==================================================================
+
+Sendet "#<n> LEDSET <id>" mit bis zu <fenster> Befehlen unterwegs und
+wartet auf "#<n> OK <latch_us> <latenz_us>". Misst pro Befehl:
+- Round-Trip am Pi (write() bis Bestaetigung)
+- ESP32-Latenz <latenz_us>: RX-Meldung bis 74HC595-Latch
+
+Fenster 1 entspricht dem alten Ablauf (ein Befehl, dann warten). Mit
+groesserem Fenster steigt der Durchsatz, bis mehrere Befehle pro IO-Zyklus
+in einem Frame zusammenfallen (gleiche latch_us).
+
+Aufruf (server.py vorher stoppen, Port ist exklusiv):
+    python3 tools/led_pipeline.py /dev/ttyACM0 500 8
+"""
+
+import os
+import select
+import statistics
+import subprocess
+import sys
+import time
+
+SERIAL_BAUD = 115200
+REPLY_TIMEOUT_S = 0.5
+LED_COUNT = 10
+
+
+def percentile(values: list, p: float) -> float:
+    ordered = sorted(values)
+    index = min(len(ordered) - 1, int(round(p / 100 * (len(ordered) - 1))))
+    return ordered[index]
+
+
+def run_pipeline(port: str, count: int, window: int) -> None:
+    subprocess.run(["stty", "-F", port, str(SERIAL_BAUD), "raw", "-echo"], check=True, capture_output=True)
+    fd = os.open(port, os.O_RDWR | os.O_NONBLOCK)
+    poll = select.poll()
+    poll.register(fd, select.POLLIN)
+
+    # Alte Daten verwerfen
+    while poll.poll(50):
+        os.read(fd, 4096)
+
+    sent_at = {}  # Tag -> Sendezeit
+    host_us = []
+    device_us = []
+    latches = set()
+    busy = 0
+    buffer = b""
+    next_tag = 0
+    t_start = time.perf_counter()
+    t_last = t_start
+
+    while (next_tag < count or sent_at) and time.perf_counter() - t_last < REPLY_TIMEOUT_S:
+        # Fenster auffuellen
+        while next_tag < count and len(sent_at) < window:
+            led = next_tag % LED_COUNT + 1
+            sent_at[next_tag] = time.perf_counter()
+            os.write(fd, f"#{next_tag} LEDSET {led:03d}\n".encode())
+            next_tag += 1
+
+        if not poll.poll(5):
+            continue
+        buffer += os.read(fd, 4096)
+        while b"\n" in buffer:
+            line, buffer = buffer.split(b"\n", 1)
+            parts = line.decode("utf-8", errors="replace").split()
+            # IO-Task latcht nicht: Befehl verworfen, nicht gemessen
+            if len(parts) == 3 and parts[1:] == ["ERROR", "BUSY"] and parts[0].startswith("#"):
+                if sent_at.pop(int(parts[0][1:]), None) is not None:
+                    busy += 1
+                continue
+            if len(parts) != 4 or not parts[0].startswith("#") or parts[1] != "OK":
+                continue
+            tag = int(parts[0][1:])
+            if tag not in sent_at:
+                continue
+            t_recv = time.perf_counter()
+            host_us.append((t_recv - sent_at.pop(tag)) * 1e6)
+            device_us.append(int(parts[3]))
+            latches.add(int(parts[2]))
+            t_last = t_recv
+
+    elapsed = time.perf_counter() - t_start
+    os.close(fd)
+    report(count, window, host_us, device_us, len(latches), len(sent_at), busy, elapsed)
+
+
+def report(count: int, window: int, host_us: list, device_us: list, frames: int, lost: int, busy: int, elapsed: float) -> None:
+    print(f"LED-Pipeline {count} Befehle, Fenster {window}, {lost} ohne Bestaetigung, {busy} BUSY")
+    if not host_us:
+        return
+    print(f"{len(host_us) / elapsed:.0f} Befehle/s, {frames} gelatchte Frames")
+    print(f"{'':<12} {'min':>8} {'mittel':>8} {'p50':>8} {'p99':>8} {'max':>8}  (us)")
+    for name, values in (("Round-Trip", host_us), ("RX->Latch", device_us)):
+        print(
+            f"{name:<12} {min(values):>8.0f} {statistics.mean(values):>8.0f} "
+            f"{percentile(values, 50):>8.0f} {percentile(values, 99):>8.0f} {max(values):>8.0f}"
+        )
+
+
+if __name__ == "__main__":
+    if len(sys.argv) < 2:
+        print(__doc__)
+        sys.exit(1)
+    run_pipeline(
+        sys.argv[1],
+        int(sys.argv[2]) if len(sys.argv) > 2 else 200,
+        int(sys.argv[3]) if len(sys.argv) > 3 else 8,
+    )
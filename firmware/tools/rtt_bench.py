@@ -0,0 +1,94 @@
+#!/usr/bin/env python3
+"""
+RTT-Messung: Befehl → Antwort ueber USB-CDC
+============================================
+
+Sendet nacheinander "RTT <n>" und wartet jeweils auf "RTT <n> <us>".
+Misst pro Befehl:
+- Round-Trip am Pi (write() bis Antwortzeile)
+- ESP32-Anteil <us>: RX-Meldung bis Antwort im TX-Puffer
+
+Mit SERIAL_RX_EVENTS=true sollte der Round-Trip nur noch aus USB-Latenz
+und Parse-Zeit bestehen; mit false kommt bis zu SERIAL_RX_POLL_MS dazu
+(ESP32-Anteil misst dann ab dem Poll, der Wartezeit-Anteil fehlt dort).
+
+Aufruf (server.py vorher stoppen, Port ist exklusiv):
+    python3 tools/rtt_bench.py /dev/ttyACM0 500
+"""
+
+import os
+import select
+import statistics
+import subprocess
+import sys
+import time
+
+SERIAL_BAUD = 115200
+REPLY_TIMEOUT_S = 0.5
+
+
+def percentile(values: list, p: float) -> float:
+    ordered = sorted(values)
+    index = min(len(ordered) - 1, int(round(p / 100 * (len(ordered) - 1))))
+    return ordered[index]
+
+
+def run_rtt(port: str, count: int) -> None:
+    subprocess.run(["stty", "-F", port, str(SERIAL_BAUD), "raw", "-echo"], check=True, capture_output=True)
+    fd = os.open(port, os.O_RDWR | os.O_NONBLOCK)
+    poll = select.poll()
+    poll.register(fd, select.POLLIN)
+
+    # Alte Daten verwerfen
+    while poll.poll(50):
+        os.read(fd, 4096)
+
+    host_us = []
+    device_us = []
+    lost = 0
+    buffer = b""
+
+    for n in range(count):
+        token = f"{n:05d}"
+        t_send = time.perf_counter()
+        os.write(fd, f"RTT {token}\n".encode())
+
+        reply = None
+        while reply is None and time.perf_counter() - t_send < REPLY_TIMEOUT_S:
+            if not poll.poll(5):
+                continue
+            buffer += os.read(fd, 4096)
+            while b"\n" in buffer and reply is None:
+                line, buffer = buffer.split(b"\n", 1)
+                parts = line.decode("utf-8", errors="replace").split()
+                if len(parts) == 3 and parts[0] == "RTT" and parts[1] == token:
+                    reply = parts
+        t_recv = time.perf_counter()
+
+        if reply is None:
+            lost += 1
+            continue
+        host_us.append((t_recv - t_send) * 1e6)
+        device_us.append(int(reply[2]))
+
+    os.close(fd)
+    report(count, host_us, device_us, lost)
+
+
+def report(count: int, host_us: list, device_us: list, lost: int) -> None:
+    print(f"RTT {count} Befehle, {lost} ohne Antwort")
+    if not host_us:
+        return
+    print(f"{'':<12} {'min':>8} {'mittel':>8} {'p50':>8} {'p99':>8} {'max':>8}  (us)")
+    for name, values in (("Round-Trip", host_us), ("ESP32", device_us)):
+        print(
+            f"{name:<12} {min(values):>8.0f} {statistics.mean(values):>8.0f} "
+            f"{percentile(values, 50):>8.0f} {percentile(values, 99):>8.0f} {max(values):>8.0f}"
+        )
+
+
+if __name__ == "__main__":
+    if len(sys.argv) < 2:
+        print(__doc__)
+        sys.exit(1)
+    run_rtt(sys.argv[1], int(sys.argv[2]) if len(sys.argv) > 2 else 200)
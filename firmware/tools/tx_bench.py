@@ -0,0 +1,100 @@
+#!/usr/bin/env python3
+"""
+TX-Benchmark: alter Sendepfad (flush + 2 ms pro Zeile) vs. CdcLineWriter
+=========================================================================
+
+Sendet "TXBENCH <n>" an den ESP32 und misst auf der Pi-Seite:
+- Latenz bis zur ersten Zeile jeder Phase
+- Durchsatz (Zeilen/s) je Phase
+- Fragmente: read()-Bloecke, die mitten in einer Zeile enden
+
+Dazu die Geraete-Sicht (Blockierzeit des Serial-Tasks) aus den
+TXBENCH-Antwortzeilen.
+
+Aufruf (server.py vorher stoppen, Port ist exklusiv):
+    python3 tools/tx_bench.py /dev/ttyACM0 200
+"""
+
+import os
+import select
+import subprocess
+import sys
+import time
+
+SERIAL_BAUD = 115200
+TIMEOUT_S = 30.0
+
+
+def run_bench(port: str, count: int) -> None:
+    subprocess.run(["stty", "-F", port, str(SERIAL_BAUD), "raw", "-echo"], check=True, capture_output=True)
+    fd = os.open(port, os.O_RDWR | os.O_NONBLOCK)
+    poll = select.poll()
+    poll.register(fd, select.POLLIN)
+
+    # Alte Daten verwerfen
+    while poll.poll(50):
+        os.read(fd, 4096)
+
+    phases = {"L": [], "C": []}  # Empfangszeit pro Zeile
+    fragments = {"L": 0, "C": 0}
+    results = []
+    buffer = b""
+
+    t_cmd = time.perf_counter()
+    os.write(fd, f"TXBENCH {count}\n".encode())
+
+    while time.perf_counter() - t_cmd < TIMEOUT_S:
+        if not poll.poll(100):
+            continue
+        data = os.read(fd, 4096)
+        now = time.perf_counter()
+        buffer += data
+
+        # Block endet mitten in einer BENCH-Zeile → Fragment
+        if not buffer.endswith(b"\n"):
+            tail = buffer.rsplit(b"\n", 1)[-1]
+            if tail.startswith(b"BENCH ") and len(tail) > 6:
+                fragments[chr(tail[6])] += 1
+
+        while b"\n" in buffer:
+            line, buffer = buffer.split(b"\n", 1)
+            text = line.decode("utf-8", errors="replace").strip()
+            if text.startswith("BENCH "):
+                phases[text[6]].append(now)
+            elif text.startswith("TXBENCH "):
+                results.append(text.split())
+            elif text in ("OK",) or text.startswith("ERROR"):
+                os.close(fd)
+                report(count, t_cmd, phases, fragments, results, text)
+                return
+
+    os.close(fd)
+    print("Timeout: keine vollstaendige Antwort")
+
+
+def report(count, t_cmd, phases, fragments, results, status) -> None:
+    print(f"TXBENCH {count} Zeilen -> {status}")
+    print(f"{'Pfad':<10} {'Zeilen':>6} {'erste ms':>9} {'Zeilen/s':>10} {'Frag':>5} {'ESP us':>9} {'Pakete':>7}")
+
+    device = {r[1]: r for r in results}
+    start = t_cmd
+    for key, name in (("L", "LEGACY"), ("C", "COALESCE")):
+        times = phases[key]
+        if not times:
+            print(f"{name:<10} keine Zeilen empfangen")
+            continue
+        first_ms = (times[0] - start) * 1000
+        span = times[-1] - times[0]
+        rate = (len(times) - 1) / span if span > 0 else float("inf")
+        dev = device.get(name, [])
+        dev_us = dev[3] if len(dev) > 3 else "-"
+        packets = dev[4] if len(dev) > 4 else "-"
+        print(f"{name:<10} {len(times):>6} {first_ms:>9.2f} {rate:>10.0f} {fragments[key]:>5} {dev_us:>9} {packets:>7}")
+        start = times[-1]
+
+
+if __name__ == "__main__":
+    if len(sys.argv) < 2:
+        print(__doc__)
+        sys.exit(1)
+    run_bench(sys.argv[1], int(sys.argv[2]) if len(sys.argv) > 2 else 200)
@@ -90,6 +90,164 @@ ESP32_SETS_LED_LOCALLY = True
 # Fragment-Timeout (ms): Warte auf Rest der Zeile bevor Fragment verarbeitet wird
 FRAGMENT_TIMEOUT_MS = 50
 
+# Multi-Touch: ESP32 meldet jede Taster-Flanke (DOWN/UP), Server kennt
+# damit alle gehaltenen Taster ohne STATUS-Polling
+ESP32_EDGE_EVENTS = False
+
+# Binaeres Protokoll (COBS + CRC16): nach READY "PROTO BIN" senden.
+# Keine Fragment-Heuristik noetig, Events mit us-Zeitstempel
+ESP32_BINARY_PROTOCOL = False
+
+# Latenz-Messung: nach READY "TRACE ON" senden. PRESS traegt dann
+# Korrelations-ID + ESP32-Zeitstempel, Server und Dashboard haengen ihre an.
+# ASCII: Fragment-Heuristik (nackte Zahl = PRESS) ist dabei aus, weil das
+# Ende einer PRESS-Zeile sonst als Phantom-PRESS gelesen werden kann.
+ESP32_LATENCY_TRACE = False
+TRACE_HISTORY = 32  # Offene Messungen (ohne Rueckmeldung vom Browser)
+
+# Uhrabgleich ESP32 <-> Pi (NTP-artig): "TIME?" / "TIME t1 t2 t3" alle
+# CLOCK_SYNC_INTERVAL_S. Bildet ESP32-Zeitstempel auf die Pi-Uhr ab,
+# damit die Latenz-Messung auch die USB-Strecke (tx -> rx) enthaelt.
+ESP32_CLOCK_SYNC = False
+CLOCK_SYNC_INTERVAL_S = 2.0
+
+# Status-Zeilen vom ESP32 (Antwort auf STATUS), werden nur geloggt
+STATUS_PREFIXES = (
+    "CURLED ",
+    "BTNS ",
+    "LEDS ",
+    "HEAP ",
+    "IOLOAD ",
+    "IOJITTER ",
+    "SPI ",
+    "TIMER ",
+    "LOGQ ",
+    "TXQ ",
+    "RXQ ",
+    "DEBOUNCE ",
+    "EDGES ",
+    "TRACE ",
+    "PROTO ",
+    "PERF ",
+)
+
+# =============================================================================
+# BINAER-PROTOKOLL (siehe firmware/src/app/bin_proto.h)
+# =============================================================================
+# Frame: COBS([op][seq][payload][crc16 LE]) + 0x00
+
+BIN_OP_PRESS = 0x01
+BIN_OP_RELEASE = 0x02
+BIN_OP_DOWN = 0x03
+BIN_OP_UP = 0x04
+BIN_OP_ACK = 0x10
+BIN_OP_PONG = 0x11
+BIN_OP_TEXT = 0x20
+BIN_OP_TEXT_MORE = 0x21  # Anfang einer Zeile > 58 Zeichen, Rest folgt
+
+BIN_CMD_OPS = {
+    "LEDSET": 0x81,
+    "LEDON": 0x82,
+    "LEDOFF": 0x83,
+    "LEDCLR": 0x84,
+    "LEDALL": 0x85,
+    "PING": 0x86,
+}
+BIN_OP_LEDMASK = 0x87
+BIN_OP_CMD_TEXT = 0xA0
+
+BIN_STATUS_NAMES = {
+    0: "OK",
+    1: "INVALID_ID",
+    2: "UNKNOWN_OP",
+    3: "BAD_LENGTH",
+    4: "BUSY",
+}
+
+
+def crc16_ccitt(data: bytes) -> int:
+    """CRC16-CCITT (Poly 0x1021, Start 0xFFFF)."""
+    crc = 0xFFFF
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) & 0xFFFF if crc & 0x8000 else (crc << 1) & 0xFFFF
+    return crc
+
+
+def cobs_encode(data: bytes) -> bytes:
+    """COBS-Kodierung (ohne 0x00-Trenner)."""
+    out = bytearray([0])
+    code_pos = 0
+    code = 1
+    for byte in data:
+        if byte == 0:
+            out[code_pos] = code
+            code_pos = len(out)
+            out.append(0)
+            code = 1
+            continue
+        out.append(byte)
+        code += 1
+        if code == 0xFF:
+            out[code_pos] = code
+            code_pos = len(out)
+            out.append(0)
+            code = 1
+    out[code_pos] = code
+    return bytes(out)
+
+
+def cobs_decode(data: bytes) -> Optional[bytes]:
+    """COBS-Dekodierung. None bei ungueltiger Kodierung."""
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        i += 1
+        if code == 0 or i + code - 1 > len(data):
+            return None
+        out += data[i : i + code - 1]
+        i += code - 1
+        if code != 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def bin_build_frame(op: int, seq: int, payload: bytes = b"") -> bytes:
+    """Baut einen Frame inkl. CRC, COBS und 0x00."""
+    raw = bytes([op, seq & 0xFF]) + payload
+    return cobs_encode(raw + crc16_ccitt(raw).to_bytes(2, "little")) + b"\x00"
+
+
+def bin_parse_frame(data: bytes) -> Optional[tuple[int, int, bytes]]:
+    """Dekodiert einen Frame (ohne 0x00). None bei COBS-/CRC-Fehler."""
+    raw = cobs_decode(data)
+    if raw is None or len(raw) < 4:
+        return None
+    if crc16_ccitt(raw[:-2]) != int.from_bytes(raw[-2:], "little"):
+        return None
+    return raw[0], raw[1], raw[2:-2]
+
+
+def bin_command_frame(command: str, seq: int) -> bytes:
+    """Uebersetzt einen ASCII-Befehl in einen Frame (sonst CMD_TEXT)."""
+    parts = command.split()
+    op = BIN_CMD_OPS.get(parts[0]) if parts else None
+    if op is not None and len(parts) == 1:
+        return bin_build_frame(op, seq)
+    if op is not None and len(parts) == 2 and parts[1].isdigit():
+        return bin_build_frame(op, seq, bytes([int(parts[1]) & 0xFF]))
+    if len(parts) == 2 and parts[0] == "LEDMASK":
+        try:
+            mask = int(parts[1], 16)
+        except ValueError:
+            mask = -1
+        if 0 <= mask < (1 << NUM_MEDIA):
+            payload = mask.to_bytes((NUM_MEDIA + 7) // 8, "little")
+            return bin_build_frame(BIN_OP_LEDMASK, seq, payload)
+    return bin_build_frame(BIN_OP_CMD_TEXT, seq, command.encode())
+
 # =============================================================================
 # GLOBALER ZUSTAND
 # =============================================================================
@@ -105,7 +263,19 @@ class AppState:
         self.serial_connected: bool = False
         self.serial_lock = threading.Lock()
         self.media_valid: dict[int, dict[str, bool]] = {}
+        self.buttons_held: set[int] = set()  # aus DOWN/UP (EDGES ON)
+        self.serial_binary: bool = False  # PROTO BIN aktiv
+        self.bin_seq: int = 0  # Laufnummer Pi -> ESP32
+        self.bin_last_rx_seq: Optional[int] = None  # Luecken = Frame-Verlust
+        self.bin_text_parts: list[bytes] = []  # TEXT_MORE bis zum TEXT
+        self.frame_errors: int = 0
+        self.frames_lost: int = 0
         self.missing_media: list[str] = []
+        self.traces: dict[int, dict] = {}  # Korrelations-ID -> Zeitstempel
+        self.last_trace: Optional[dict] = None  # Letzte Aufschluesselung
+        self.clock_t1: Optional[int] = None  # Offene TIME?-Messung (Pi-us)
+        self.clock_ref_us: Optional[int] = None  # Mitte der letzten Messung
+        self.clock: Optional[dict] = None  # Letzte Schaetzung (Offset/Drift)
 
     async def broadcast(self, message: dict) -> None:
         """Sendet Nachricht an alle WebSocket-Clients."""
@@ -135,7 +305,11 @@ class AppState:
 
         try:
             with self.serial_lock:
-                os.write(self.serial_fd, f"{command}\n".encode())
+                if self.serial_binary:
+                    self.bin_seq = (self.bin_seq + 1) & 0xFF
+                    os.write(self.serial_fd, bin_command_frame(command, self.bin_seq))
+                else:
+                    os.write(self.serial_fd, f"{command}\n".encode())
             logging.debug(f"Serial TX: {command}")
             return True
         except Exception as e:
@@ -211,8 +385,13 @@ def check_media_exists(media_id: int) -> dict:
 # =============================================================================
 
 
-async def handle_serial_line(line: str) -> None:
-    """Verarbeitet eine Zeile vom ESP32."""
+async def handle_serial_line(line: str, framed: bool = False, rx_us: Optional[int] = None) -> None:
+    """
+    Verarbeitet eine Zeile vom ESP32 (framed: aus TEXT-Frame, nie Fragment).
+
+    rx_us: Ankunft im Reader-Thread (pi_now_us()), unabhaengig davon, wann
+    der asyncio-Loop die Zeile abarbeitet.
+    """
     line = line.strip()
     if not line:
         return
@@ -220,15 +399,21 @@ async def handle_serial_line(line: str) -> None:
     logging.debug(f"Serial RX: '{line}'")
 
     # PRESS erkennen (vollständig)
+    # TRACE ON: "PRESS <id> <pid> <edge_us> <deb_us> <tx_us>"
     if line.startswith("PRESS "):
-        button_id = parse_button_id(line[6:])
+        parts = line.split()
+        button_id = parse_button_id(parts[1]) if len(parts) >= 2 else None
         if button_id:
-            await handle_button_press(button_id)
+            trace = None
+            if len(parts) == 6 and all(p.isdigit() for p in parts[2:]):
+                pid, edge_us, deb_us, tx_us = (int(p) for p in parts[2:])
+                trace = new_trace(pid, button_id, edge_us, deb_us, tx_us, rx_us)
+            await handle_button_press(button_id, trace)
             return
 
     # Fallback: Fragmentiertes PRESS (nur Zahl ohne "PRESS " Prefix)
     # USB-CDC kann "PRESS " und "003" als separate Zeilen senden
-    if not line.startswith("RE") and not line.startswith("SE"):
+    if not framed and not ESP32_LATENCY_TRACE and not line.startswith("RE") and not line.startswith("SE"):
         button_id = parse_button_id(line)
         if button_id:
             logging.debug(f"Fragmentiertes PRESS: '{line}' -> Button {button_id}")
@@ -240,10 +425,35 @@ async def handle_serial_line(line: str) -> None:
         logging.debug(f"Button released: {line[8:]}")
         return
 
+    # Uhrabgleich: "TIME <t2>" (Antwort auf TIME?) bzw.
+    # "TIME <offset_us> <drift_ppb> <rtt_us> <messungen>" (Schaetzung)
+    if line.startswith("TIME "):
+        handle_clock_reply(line.split(), rx_us)
+        return
+
+    # Taster-Flanken (EDGES ON): "DOWN 003 <us>" / "UP 003 <us>"
+    if line.startswith("DOWN ") or line.startswith("UP "):
+        parts = line.split()
+        button_id = parse_button_id(parts[1]) if len(parts) >= 2 else None
+        if button_id:
+            if parts[0] == "DOWN":
+                state.buttons_held.add(button_id)
+            else:
+                state.buttons_held.discard(button_id)
+            logging.debug(f"Taster {parts[0]} {button_id}, gehalten: {sorted(state.buttons_held)}")
+        return
+
     # Standard-Befehle
     if line == "READY":
         logging.info("ESP32 ist bereit")
         state.serial_connected = True
+        state.buttons_held.clear()
+        if ESP32_EDGE_EVENTS:
+            await state.send_serial("EDGES ON")
+        if ESP32_LATENCY_TRACE:
+            await state.send_serial("TRACE ON")
+        if ESP32_BINARY_PROTOCOL:
+            await state.send_serial("PROTO BIN")
 
     elif line == "PONG":
         logging.debug("PING-Antwort erhalten")
@@ -254,16 +464,81 @@ async def handle_serial_line(line: str) -> None:
     elif line.startswith("ERROR "):
         logging.warning(f"ESP32 Fehler: {line[6:]}")
 
+    elif line.startswith("BATCH "):
+        # "BATCH <n> <fehler_hex>": Bit i = Eintrag i+1 fehlerhaft
+        parts = line.split()
+        if len(parts) >= 3 and parts[2] != "0":
+            logging.warning(f"ESP32 Batch-Fehler: {line}")
+
+    elif line.startswith("#"):
+        # Getaggte Antwort: "#n OK [<latch_us> <latenz_us>]" / "#n ERROR <msg>"
+        if " ERROR " in line:
+            logging.warning(f"ESP32 Fehler: {line}")
+        else:
+            logging.debug(f"ESP32: {line}")
+
     elif line.startswith("FW "):
         logging.info(f"ESP32 Firmware: {line}")
 
     elif line.startswith("MODE "):
         logging.info(f"ESP32 Modus: {line[5:]}")
 
-    elif line.startswith("CURLED ") or line.startswith("BTNS ") or line.startswith("LEDS ") or line.startswith("HEAP "):
+    elif line.startswith(STATUS_PREFIXES):
         logging.debug(f"ESP32 Status: {line}")
 
 
+async def handle_serial_frame(op: int, seq: int, payload: bytes, rx_us: Optional[int] = None) -> None:
+    """Verarbeitet einen Binaer-Frame vom ESP32 (CRC bereits geprueft, rx_us wie handle_serial_line)."""
+    # ACK/PONG tragen die Befehls-seq, alle anderen die ESP32-Laufnummer
+    if op not in (BIN_OP_ACK, BIN_OP_PONG):
+        last = state.bin_last_rx_seq
+        if last is not None and seq != (last + 1) & 0xFF:
+            state.frames_lost += (seq - last - 1) & 0xFF
+            logging.warning(f"Binaer-Frames verloren: seq {last} -> {seq}")
+            state.bin_text_parts.clear()  # Zeile unvollstaendig
+        state.bin_last_rx_seq = seq
+
+    # TRACE ON: PRESS mit [id][us32][pid16][edge32][tx32]
+    if op in (BIN_OP_PRESS, BIN_OP_RELEASE, BIN_OP_DOWN, BIN_OP_UP) and len(payload) in (5, 15):
+        button_id = payload[0]
+        us = int.from_bytes(payload[1:5], "little")
+        if not 1 <= button_id <= NUM_MEDIA:
+            return
+        if op == BIN_OP_PRESS:
+            trace = None
+            if len(payload) == 15:
+                pid = int.from_bytes(payload[5:7], "little")
+                edge_us = int.from_bytes(payload[7:11], "little")
+                tx_us = int.from_bytes(payload[11:15], "little")
+                trace = new_trace(pid, button_id, edge_us, us, tx_us, rx_us)
+            await handle_button_press(button_id, trace)
+        elif op == BIN_OP_RELEASE:
+            logging.debug(f"Button released: {button_id} @{us} us")
+        elif op == BIN_OP_DOWN:
+            state.buttons_held.add(button_id)
+        else:
+            state.buttons_held.discard(button_id)
+
+    elif op == BIN_OP_ACK and payload:
+        if payload[0] != 0:
+            logging.warning(f"ESP32 Fehler (seq {seq}): {BIN_STATUS_NAMES.get(payload[0], payload[0])}")
+        elif len(payload) == 9:
+            # LED-Befehl gelatcht: [status][latch_us][latenz_us]
+            latency_us = int.from_bytes(payload[5:9], "little")
+            logging.debug(f"LED gelatcht (seq {seq}): {latency_us} us nach RX")
+
+    elif op == BIN_OP_PONG:
+        logging.debug("PING-Antwort erhalten")
+
+    elif op == BIN_OP_TEXT_MORE:
+        state.bin_text_parts.append(payload)
+
+    elif op == BIN_OP_TEXT:
+        text = b"".join(state.bin_text_parts) + payload
+        state.bin_text_parts.clear()
+        await handle_serial_line(text.decode("utf-8", errors="replace"), framed=True, rx_us=rx_us)
+
+
 def parse_button_id(s: str) -> int | None:
     """Extrahiert Button-ID aus String (1-NUM_MEDIA). Gibt None zurück bei Fehler."""
     s = s.strip()
@@ -282,12 +557,142 @@ def parse_button_id(s: str) -> int | None:
     return None
 
 
-async def handle_button_press(button_id: int) -> None:
+def pi_now_us() -> int:
+    """Monotone Pi-Uhr in us (CLOCK_MONOTONIC, auch im Reader-Thread)."""
+    return time.monotonic_ns() // 1000
+
+
+def handle_clock_reply(parts: list[str], rx_us: Optional[int] = None) -> None:
+    """
+    Verarbeitet eine TIME-Zeile vom ESP32.
+
+    Zwei Token: ESP32-Zeit t2 zur offenen Messung -> t3 = Ankunft im
+    Reader-Thread (rx_us; Wartezeit im asyncio-Loop zaehlt sonst als RTT)
+    und "TIME t1 t2 t3" zurueckschicken. Fuenf Token: neue Schaetzung, gilt fuer
+    die Pi-Zeit in der Mitte der Round-Trip (Bezugspunkt der Drift).
+    """
+    if not all(p.lstrip("-").isdigit() for p in parts[1:]):
+        logging.warning(f"ESP32 Uhrabgleich ungueltig: {' '.join(parts)}")
+        return
+
+    if len(parts) == 2:
+        t3 = rx_us if rx_us is not None else pi_now_us()
+        t1, state.clock_t1 = state.clock_t1, None
+        if t1 is None:
+            return  # Keine offene Messung (z.B. TIME? von Hand)
+        state.clock_ref_us = (t1 + t3) // 2
+        asyncio.ensure_future(state.send_serial(f"TIME {t1} {parts[1]} {t3}"))
+
+    elif len(parts) == 5:
+        offset_us, drift_ppb, rtt_us, samples = (int(p) for p in parts[1:])
+        state.clock = {
+            "offset_us": offset_us,
+            "drift_ppb": drift_ppb,
+            "rtt_us": rtt_us,
+            "samples": samples,
+            "ref_us": state.clock_ref_us if state.clock_ref_us is not None else pi_now_us(),
+        }
+        logging.debug(f"ESP32 Uhr: Offset {offset_us} us, Drift {drift_ppb} ppb, RTT {rtt_us} us ({samples} Messungen)")
+
+
+def esp_to_pi_us(esp_us32: int) -> Optional[int]:
+    """
+    Bildet einen ESP32-Zeitstempel (micros(), 32 Bit) auf die Pi-Uhr ab.
+
+    esp = pi + offset + drift * (pi - ref). Die fehlenden oberen Bits kommen
+    aus der aktuell geschaetzten ESP32-Zeit (Zeitstempel liegt in der
+    Vergangenheit, weniger als 71 Minuten).
+    """
+    clock = state.clock
+    if clock is None:
+        return None
+    drift = clock["drift_ppb"] / 1e9
+    now = pi_now_us()
+    esp_now = now + clock["offset_us"] + round(drift * (now - clock["ref_us"]))
+    esp_full = esp_now - ((esp_now - esp_us32) & 0xFFFFFFFF)
+    pi_approx = esp_full - clock["offset_us"]
+    return pi_approx - round(drift * (pi_approx - clock["ref_us"]))
+
+
+async def clock_sync_task() -> None:
+    """Startet periodisch eine Messung (TIME?) fuer den Uhrabgleich."""
+    while True:
+        await asyncio.sleep(CLOCK_SYNC_INTERVAL_S)
+        if not state.serial_connected:
+            continue
+        state.clock_t1 = pi_now_us()
+        await state.send_serial("TIME?")
+
+
+def new_trace(pid: int, button_id: int, edge_us: int, deb_us: int, tx_us: int, rx_us: Optional[int] = None) -> dict:
+    """
+    Legt eine Latenz-Messung an (Zeitstempel des ESP32 + Ankunft am Pi).
+
+    rx_us: Ankunft im Reader-Thread; usb_ms enthaelt so keine Wartezeit im
+    asyncio-Loop (die zaehlt zu server_ms, gleiche Uhr pi_now_us()).
+    """
+    return {
+        "pid": pid,
+        "id": button_id,
+        "edge_us": edge_us,
+        "deb_us": deb_us,
+        "tx_us": tx_us,
+        "rx_us": rx_us if rx_us is not None else pi_now_us(),
+    }
+
+
+def finish_trace(pid: int, play_ms: float) -> None:
+    """
+    Schliesst eine Latenz-Messung mit der Rueckmeldung des Browsers ab.
+
+    ESP32-Abschnitte kommen aus micros() (gleiche Uhr, Ueberlauf egal),
+    Server und WebSocket aus pi_now_us() am Pi. USB (tx -> rx) laeuft
+    ueber zwei Uhren und ist nur mit Uhrabgleich (ESP32_CLOCK_SYNC) messbar,
+    Genauigkeit etwa halbe Round-Trip.
+    WebSocket: halbe Rundreise ohne die Browser-Zeit (symmetrisch angenommen).
+    """
+    trace = state.traces.pop(pid, None)
+    if trace is None:
+        return  # Unbekannt, zu alt oder schon von anderem Client gemeldet
+
+    now_us = pi_now_us()
+    tx_pi_us = esp_to_pi_us(trace["tx_us"])
+    breakdown = {
+        "pid": pid,
+        "id": trace["id"],
+        "debounce_ms": ((trace["deb_us"] - trace["edge_us"]) & 0xFFFFFFFF) / 1000,
+        "esp32_ms": ((trace["tx_us"] - trace["deb_us"]) & 0xFFFFFFFF) / 1000,
+        "usb_ms": max(0.0, (trace["rx_us"] - tx_pi_us) / 1000) if tx_pi_us is not None else None,
+        "server_ms": (trace["sent_us"] - trace["rx_us"]) / 1000,
+        "websocket_ms": max(0.0, ((now_us - trace["sent_us"]) / 1000 - play_ms) / 2),
+        "browser_ms": play_ms,
+    }
+    breakdown["total_ms"] = sum(v for k, v in breakdown.items() if k.endswith("_ms") and v is not None)
+    for key, value in breakdown.items():
+        if isinstance(value, float):
+            breakdown[key] = round(value, 2)
+    state.last_trace = breakdown
+
+    usb = "?" if breakdown["usb_ms"] is None else f"~{breakdown['usb_ms']:.1f}"
+    logging.info(
+        f"Latenz #{pid} Taster {trace['id']}: "
+        f"Entprellen {breakdown['debounce_ms']:.1f} ms, "
+        f"ESP32 {breakdown['esp32_ms']:.1f} ms, "
+        f"USB {usb} ms, "
+        f"Server {breakdown['server_ms']:.1f} ms, "
+        f"WebSocket ~{breakdown['websocket_ms']:.1f} ms, "
+        f"Browser {breakdown['browser_ms']:.1f} ms "
+        f"= {breakdown['total_ms']:.1f} ms"
+    )
+
+
+async def handle_button_press(button_id: int, trace: Optional[dict] = None) -> None:
     """
     Verarbeitet Tastendruck (Preempt-Policy) mit minimaler Latenz.
 
     Args:
         button_id: 1-basierte ID (Taster 1-100, Medien 001-100)
+        trace: Latenz-Messung (TRACE ON), sonst None
     """
     if button_id < 1 or button_id > NUM_MEDIA:
         logging.warning(f"Button-ID ausserhalb Bereich: {button_id} (erlaubt: 1-{NUM_MEDIA})")
@@ -310,12 +715,21 @@ async def handle_button_press(button_id: int) -> None:
     # 2. Browser: Stop-Signal
     tasks.append(state.broadcast({"type": "stop"}))
 
-    # 3. Browser: Play-Signal
-    tasks.append(state.broadcast({"type": "play", "id": button_id}))
+    # 3. Browser: Play-Signal (mit Korrelations-ID fuer die Rueckmeldung)
+    play = {"type": "play", "id": button_id}
+    if trace is not None:
+        play["pid"] = trace["pid"]
+    tasks.append(state.broadcast(play))
 
     if tasks:
         await asyncio.gather(*tasks)
 
+    if trace is not None:
+        trace["sent_us"] = pi_now_us()
+        state.traces[trace["pid"]] = trace
+        if len(state.traces) > TRACE_HISTORY:
+            state.traces.pop(next(iter(state.traces)))  # Aelteste zuerst
+
 
 async def handle_playback_ended(ended_id: int) -> None:
     """
@@ -365,6 +779,28 @@ async def serial_reader_task() -> None:
                 buffer = b""
                 pending_fragment = ""
                 last_data_time = 0
+                binary = False  # Nach (Re-)Connect sendet der ESP32 ASCII
+                state.serial_binary = False
+                state.bin_last_rx_seq = None
+                state.bin_text_parts = []
+
+                def process_frames(buf: bytes, rx_us: int) -> tuple[bytes, bool]:
+                    """Verarbeitet alle vollstaendigen Frames (bis 0x00), rx_us = Ankunft."""
+                    while b"\x00" in buf:
+                        data, buf = buf.split(b"\x00", 1)
+                        if not data:
+                            continue
+                        frame = bin_parse_frame(data)
+                        if frame is None:
+                            # Kaputter Frame: ab dem naechsten 0x00 wieder synchron
+                            state.frame_errors += 1
+                            logging.debug(f"Binaer-Frame verworfen: {data.hex()}")
+                            continue
+                        asyncio.run_coroutine_threadsafe(handle_serial_frame(*frame, rx_us), loop)
+                        if frame[0] == BIN_OP_TEXT and frame[2] == b"PROTO ASCII":
+                            state.serial_binary = False
+                            return buf, False
+                    return buf, True
                 poll = select.poll()
                 poll.register(fd_read, select.POLLIN)
 
@@ -377,14 +813,25 @@ async def serial_reader_task() -> None:
                             if event & select.POLLIN:
                                 try:
                                     data = os.read(fd_read, 1024)
+                                    rx_us = pi_now_us()  # t3 fuer TIME: hier, nicht im Loop
                                     if data:
                                         buffer += data
                                         last_data_time = current_time
 
-                                        while b"\n" in buffer:
+                                        if binary:
+                                            buffer, binary = process_frames(buffer, rx_us)
+
+                                        while not binary and b"\n" in buffer:
                                             line, buffer = buffer.split(b"\n", 1)
                                             line_str = line.decode("utf-8", errors="replace").strip()
 
+                                            # Letzte ASCII-Zeile, danach nur Frames
+                                            if line_str == "PROTO BIN":
+                                                logging.info("Serial: Binaer-Protokoll aktiv")
+                                                state.serial_binary = True
+                                                buffer, binary = process_frames(buffer, rx_us)
+                                                continue
+
                                             if line_str:
                                                 if pending_fragment:
                                                     combined = pending_fragment + line_str
@@ -394,15 +841,20 @@ async def serial_reader_task() -> None:
                                                     pending_fragment = ""
 
                                                     if combined.startswith("PRESS "):
-                                                        asyncio.run_coroutine_threadsafe(handle_serial_line(combined), loop)
+                                                        asyncio.run_coroutine_threadsafe(handle_serial_line(combined, rx_us=rx_us), loop)
                                                         continue
 
-                                                asyncio.run_coroutine_threadsafe(handle_serial_line(line_str), loop)
+                                                asyncio.run_coroutine_threadsafe(handle_serial_line(line_str, rx_us=rx_us), loop)
 
                                 except BlockingIOError:
                                     pass
 
-                        if buffer and (current_time - last_data_time) > FRAGMENT_TIMEOUT_MS:
+                        # Binaer: angefangener Frame wartet auf sein 0x00
+                        if binary and len(buffer) > 1024:
+                            state.frame_errors += 1
+                            buffer = b""
+
+                        if not binary and buffer and (current_time - last_data_time) > FRAGMENT_TIMEOUT_MS:
                             fragment = buffer.decode("utf-8", errors="replace").strip()
                             if fragment:
                                 if fragment in ("PRESS", "PRES", "PRE", "PR", "P"):
@@ -413,7 +865,7 @@ async def serial_reader_task() -> None:
                                     logging.debug(f"Incomplete PRESS fragment: '{fragment}'")
                                 else:
                                     logging.debug(f"Fragment-Timeout: '{fragment}'")
-                                    button_id = parse_button_id(fragment)
+                                    button_id = None if ESP32_LATENCY_TRACE else parse_button_id(fragment)
                                     if button_id:
                                         logging.debug(f"Fragmentiertes PRESS erkannt: '{fragment}' -> {button_id}")
                                         asyncio.run_coroutine_threadsafe(handle_button_press(button_id), loop)
@@ -499,6 +951,13 @@ async def handle_ws_message(data: dict) -> None:
         else:
             logging.warning(f"'ended' ohne gueltige ID: {data}")
 
+    elif msg_type == "trace":
+        # Latenz-Messung: Browser meldet Empfang -> Wiedergabe
+        pid = data.get("pid")
+        play_ms = data.get("play_ms")
+        if isinstance(pid, int) and isinstance(play_ms, (int, float)):
+            finish_trace(pid, float(play_ms))
+
     elif msg_type == "ping":
         pass
 
@@ -560,12 +1019,19 @@ async def status_handler(request: web.Request) -> web.Response:
             "mode": "prototype" if PROTOTYPE_MODE else "production",
             "num_media": NUM_MEDIA,
             "current_button": state.current_id,
+            "buttons_held": sorted(state.buttons_held),
             "ws_clients": len(state.ws_clients),
             "serial_connected": state.serial_connected,
             "serial_port": SERIAL_PORT,
             "media_missing": len(state.missing_media),
             "missing_files": state.missing_media[:10] if state.missing_media else [],
             "esp32_local_led": ESP32_SETS_LED_LOCALLY,
+            "serial_protocol": "bin" if state.serial_binary else "ascii",
+            "serial_frame_errors": state.frame_errors,
+            "serial_frames_lost": state.frames_lost,
+            "latency_trace": ESP32_LATENCY_TRACE,
+            "last_trace": state.last_trace,
+            "clock_sync": state.clock if ESP32_CLOCK_SYNC else None,
         }
     )
 
@@ -616,9 +1082,13 @@ def create_app() -> web.Application:
 
 async def start_background_tasks(app: web.Application) -> None:
     app["serial_task"] = asyncio.create_task(serial_reader_task())
+    if ESP32_CLOCK_SYNC:
+        app["clock_task"] = asyncio.create_task(clock_sync_task())
 
 
 async def cleanup_background_tasks(app: web.Application) -> None:
+    if "clock_task" in app:
+        app["clock_task"].cancel()
     app["serial_task"].cancel()
     try:
         await app["serial_task"]